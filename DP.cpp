@@ -6,18 +6,114 @@
 #include <string>
 #include <algorithm>
 #include <climits> // Para usar INT_MAX
+#include <limits> // Para el máximo de cada ancho de celda
 #include <stdexcept> // Para excepciones
 #include <chrono> // Para medir tiempos
+#include <cmath> // Para las casillas logarítmicas del histograma de latencias
 #include <utility> // Para manejar pares y otros utilitarios
+#include <random> // Para generar cadenas de prueba
+#include <sys/resource.h> // Para medir la memoria máxima usada (getrusage)
+#include <cstring> // Para memcpy
+#include <thread> // Para el DP paralelo por bloques
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <new> // Para std::bad_alloc (conteo de pedidos de memoria en las métricas)
+#include <queue>
+#include <cstdint> // Para uint64_t (vectores de bits)
+#include <cstdlib> // Para getenv
+#include <fcntl.h> // Para abrir y mapear los perfiles binarios
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/socket.h> // Para el servidor por socket Unix
+#include <sys/un.h>
+#include <cerrno>
+#include <csignal>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // Instrucciones SIMD (SSE4.1 / AVX2)
+#define DP_SIMD_X86 1
+#endif
 
 // Tamaño del alfabeto (26 letras en inglés)
 const int ALPHABET_SIZE = 26;
 
 // Tablas y matrices de costos para las operaciones de edición
-std::array<int, ALPHABET_SIZE> cost_delete_table; // Costos de eliminación por letra
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix; // Costos de transposición entre pares de letras
-std::array<int, ALPHABET_SIZE> cost_insert_table; // Costos de inserción por letra
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix; // Costos de sustitución entre pares de letras
+alignas(64) std::array<int, ALPHABET_SIZE> cost_delete_table; // Costos de eliminación por letra
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix; // Costos de transposición entre pares de letras
+alignas(64) std::array<int, ALPHABET_SIZE> cost_insert_table; // Costos de inserción por letra
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix; // Costos de sustitución entre pares de letras
+
+// Métricas opcionales: compilar con -DDP_METRICAS. Sin esa bandera las macros no generan código
+// y el programa queda igual. Con ella se cuentan las celdas del DP, las consultas a las funciones
+// de costo (costo_sub, cost_ins, cost_del, cost_trans) y los pedidos de memoria dinámica, se mide
+// cada fase (carga de costos, reserva de memoria y llenado) y los bytes pedidos para las tablas del
+// DP, y al terminar se escribe todo como JSON en stderr o en el archivo indicado por METRICAS_JSON.
+// Los contadores son atómicos (el modo por lotes usa varias hebras) y los motores rápidos suman una
+// vez por llamada o por fila, nunca por celda.
+#ifdef DP_METRICAS
+struct Metricas {
+    std::atomic<unsigned long long> celdas{0};
+    std::atomic<unsigned long long> consultasCosto{0};
+    std::atomic<unsigned long long> bytesDp{0};
+    std::atomic<unsigned long long> cargaNs{0};
+    std::atomic<unsigned long long> reservaNs{0};
+    std::atomic<unsigned long long> llenadoNs{0};
+    std::atomic<unsigned long long> reservas{0}; // llamadas a operator new
+};
+Metricas metricas;
+
+// Contar cada pedido de memoria dinámica del programa (vectores, cadenas, etc.). Sin inline: si
+// GCC ve el malloc de adentro junto al delete del llamador, avisa de un par mal combinado.
+__attribute__((noinline)) void* operator new(size_t bytes) {
+    metricas.reservas.fetch_add(1, std::memory_order_relaxed);
+    if (void* memoria = std::malloc(bytes ? bytes : 1)) {
+        return memoria;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memoria) noexcept {
+    std::free(memoria);
+}
+
+__attribute__((noinline)) void operator delete(void* memoria, size_t) noexcept {
+    std::free(memoria);
+}
+
+#define METRICA_SUMAR(campo, valor) metricas.campo.fetch_add((valor), std::memory_order_relaxed)
+#define METRICA_INICIO(nombre) auto nombre = std::chrono::steady_clock::now()
+#define METRICA_FIN(nombre, campo) \
+    METRICA_SUMAR(campo, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - nombre).count())
+
+// Escribir las métricas como JSON (se registra con atexit al comenzar main)
+void exportarMetricas() {
+    std::ofstream archivo;
+    const char* ruta = std::getenv("METRICAS_JSON");
+    if (ruta != nullptr) {
+        archivo.open(ruta);
+    }
+    std::ostream& salida = archivo.is_open() ? static_cast<std::ostream&>(archivo) : std::cerr;
+    salida << "{\"programa\": \"DP\", \"celdas\": " << metricas.celdas
+           << ", \"consultas_costo\": " << metricas.consultasCosto
+           << ", \"bytes_dp\": " << metricas.bytesDp
+           << ", \"reservas_memoria\": " << metricas.reservas
+           << ", \"fases_us\": {\"carga\": " << metricas.cargaNs / 1000.0
+           << ", \"reserva\": " << metricas.reservaNs / 1000.0
+           << ", \"llenado\": " << metricas.llenadoNs / 1000.0 << "}}" << std::endl;
+}
+#else
+#define METRICA_SUMAR(campo, valor) ((void)0)
+#define METRICA_INICIO(nombre) ((void)0)
+#define METRICA_FIN(nombre, campo) ((void)0)
+#endif
+
+// Costo común cuando las tablas cargadas son uniformes (ver detectarCostosUniformes), 0 si no lo son
+int costo_uniforme = 0;
 
 // Cargar los costos de eliminación desde un archivo
 void cargarTablaCostosEliminacion(const std::string& nombreArchivo) {
@@ -100,6 +196,283 @@ void cargar_matriz_costos(const std::string& filename) {
     file.close();
 }
 
+// Revisar si las cuatro tablas cargadas son uniformes: inserción, eliminación, transposición y
+// sustitución entre letras distintas cuestan todas lo mismo (c > 0) y sustituir una letra por sí
+// misma cuesta 0. En ese caso la distancia es c por la distancia de costo unitario, y se puede
+// usar el motor de vectores de bits. Se llama después de los cuatro cargadores.
+void detectarCostosUniformes() {
+    int c = cost_insert_table[0];
+    bool uniforme = c > 0;
+    for (int a = 0; a < ALPHABET_SIZE && uniforme; ++a) {
+        if (cost_insert_table[a] != c || cost_delete_table[a] != c) {
+            uniforme = false;
+        }
+        for (int b = 0; b < ALPHABET_SIZE && uniforme; ++b) {
+            if (cost_matrix[a][b] != (a == b ? 0 : c) || cost_transpose_matrix[a][b] != c) {
+                uniforme = false;
+            }
+        }
+    }
+    costo_uniforme = uniforme ? c : 0;
+    if (uniforme) {
+        std::cout << "Costos uniformes detectados (c = " << c << "): se usará el motor de vectores de bits." << std::endl;
+    }
+}
+
+// Si alguna tabla cargada tiene costos negativos dejan de valer las cotas (distancia acotada,
+// celdas angostas, matriz de todos contra todos) y el recorte de prefijo y sufijo. En true hasta
+// revisarCostosNegativos(), para que sin revisar se use el camino que no depende de ellos.
+bool costos_negativos = true;
+
+// Revisar las cuatro tablas una vez; se llama después de los cuatro cargadores
+void revisarCostosNegativos() {
+    bool negativos = false;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        negativos = negativos || cost_insert_table[a] < 0 || cost_delete_table[a] < 0;
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            negativos = negativos || cost_matrix[a][b] < 0 || cost_transpose_matrix[a][b] < 0;
+        }
+    }
+    costos_negativos = negativos;
+}
+
+// Etapa de reducción: quitar el prefijo y el sufijo comunes antes del DP. Quitar una letra x igual
+// al comienzo (o al final) de A y B no cambia la distancia si sustituir cualquier letra por sí
+// misma cuesta 0 y, para toda letra y, ins(y) <= ins(x) + sub(x, y) y del(y) <= del(x) + sub(y, x):
+// cualquier camino que no empareje las dos x se cambia por uno que sí, sin costar más (se inserta
+// o borra y directamente en vez de pasar por x). Eso incluye una transposición que cruce el corte,
+// que se cambia por emparejar las x e insertar o borrar la otra letra. Solo se recortan las letras
+// que cumplen la condición con las tablas cargadas, y se comparan los caracteres tal cual (como
+// la transposición), así que las mayúsculas cortan el recorte.
+std::array<bool, ALPHABET_SIZE> letraRecortable{}; // todo en false: sin recorte hasta prepararRecorte()
+
+// Revisar la condición para cada letra (con costos negativos no se recorta nada: el argumento de
+// arriba cambia un camino por otro que no cuesta más solo si ningún costo es negativo); se llama
+// después de revisarCostosNegativos()
+void prepararRecorte() {
+    bool identidadGratis = !costos_negativos;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        identidadGratis = identidadGratis && cost_matrix[a][a] == 0;
+    }
+    for (int x = 0; x < ALPHABET_SIZE; ++x) {
+        bool recortable = identidadGratis;
+        for (int y = 0; y < ALPHABET_SIZE && recortable; ++y) {
+            recortable = cost_insert_table[y] <= cost_insert_table[x] + cost_matrix[x][y] &&
+                         cost_delete_table[y] <= cost_delete_table[x] + cost_matrix[y][x];
+        }
+        letraRecortable[x] = recortable;
+    }
+}
+
+struct Recorte {
+    int prefijo = 0;
+    int sufijo = 0;
+};
+
+// Largo del prefijo y del sufijo comunes que se pueden quitar (sin solaparse)
+Recorte recortarComunes(const std::string& A, const std::string& B) {
+    auto recortable = [](char c) {
+        unsigned char u = static_cast<unsigned char>(c);
+        return std::isalpha(u) && letraRecortable[std::tolower(u) - 'a'];
+    };
+    Recorte r;
+    int largo = std::min(A.size(), B.size());
+    while (r.prefijo < largo && A[r.prefijo] == B[r.prefijo] && recortable(A[r.prefijo])) {
+        ++r.prefijo;
+    }
+    while (r.sufijo < largo - r.prefijo && A[A.size() - 1 - r.sufijo] == B[B.size() - 1 - r.sufijo] &&
+           recortable(A[A.size() - 1 - r.sufijo])) {
+        ++r.sufijo;
+    }
+    return r;
+}
+
+// Perfiles de costos binarios
+// Un archivo de perfiles guarda varias combinaciones de las cuatro tablas, ya validadas, para
+// cargarlas sin volver a leer texto. Formato (enteros en el orden de bytes de la máquina):
+//   EncabezadoPerfiles (64 bytes): "COSTOS01", versión, cantidad de perfiles y tamaño del alfabeto
+//   PerfilBinario por cada perfil: nombre, suma de verificación y las cuatro tablas, alineado a 64
+// El archivo se mapea en memoria (mmap) y se copia el perfil elegido a las tablas globales.
+const char MAGIA_PERFILES[8] = {'C', 'O', 'S', 'T', 'O', 'S', '0', '1'};
+const uint32_t VERSION_PERFILES = 1;
+
+struct alignas(64) EncabezadoPerfiles {
+    char magia[8];
+    uint32_t version;
+    uint32_t cantidad;
+    uint32_t alfabeto;
+};
+
+struct alignas(64) PerfilBinario {
+    char nombre[32];
+    uint64_t suma;      // FNV-1a de 64 bits sobre las cuatro tablas
+    char relleno[24];   // para que las tablas partan alineadas a 64 bytes
+    int32_t insertar[ALPHABET_SIZE];
+    int32_t eliminar[ALPHABET_SIZE];
+    int32_t sustituir[ALPHABET_SIZE][ALPHABET_SIZE];
+    int32_t transponer[ALPHABET_SIZE][ALPHABET_SIZE];
+};
+
+static_assert(sizeof(EncabezadoPerfiles) == 64, "El encabezado debe ocupar 64 bytes");
+static_assert(sizeof(PerfilBinario) % 64 == 0, "Cada perfil debe quedar alineado a 64 bytes");
+
+// Suma de verificación de las tablas de un perfil
+uint64_t sumaPerfil(const PerfilBinario& perfil) {
+    const unsigned char* inicio = reinterpret_cast<const unsigned char*>(perfil.insertar);
+    const unsigned char* fin = reinterpret_cast<const unsigned char*>(perfil.transponer + ALPHABET_SIZE);
+    uint64_t suma = 1469598103934665603ULL;
+    for (const unsigned char* p = inicio; p != fin; ++p) {
+        suma = (suma ^ *p) * 1099511628211ULL;
+    }
+    return suma;
+}
+
+// Archivo de perfiles mapeado en memoria; se mantiene abierto para poder cambiar de perfil
+class ArchivoPerfiles {
+public:
+    explicit ArchivoPerfiles(const std::string& ruta) {
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error al abrir el archivo de perfiles: " + ruta);
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(EncabezadoPerfiles))) {
+            close(descriptor);
+            throw std::runtime_error("Archivo de perfiles incompleto: " + ruta);
+        }
+        tamano = info.st_size;
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("No se pudo mapear el archivo de perfiles: " + ruta);
+        }
+        datos = static_cast<const unsigned char*>(mapa);
+
+        const EncabezadoPerfiles* encabezado = reinterpret_cast<const EncabezadoPerfiles*>(datos);
+        if (std::memcmp(encabezado->magia, MAGIA_PERFILES, sizeof(MAGIA_PERFILES)) != 0 ||
+            encabezado->version != VERSION_PERFILES || encabezado->alfabeto != ALPHABET_SIZE ||
+            tamano != sizeof(EncabezadoPerfiles) + encabezado->cantidad * sizeof(PerfilBinario)) {
+            munmap(const_cast<unsigned char*>(datos), tamano);
+            throw std::runtime_error("El archivo '" + ruta + "' no es un archivo de perfiles válido");
+        }
+        cantidad = encabezado->cantidad;
+        perfiles = reinterpret_cast<const PerfilBinario*>(datos + sizeof(EncabezadoPerfiles));
+    }
+
+    ~ArchivoPerfiles() {
+        munmap(const_cast<unsigned char*>(datos), tamano);
+    }
+
+    ArchivoPerfiles(const ArchivoPerfiles&) = delete;
+    ArchivoPerfiles& operator=(const ArchivoPerfiles&) = delete;
+
+    // Buscar un perfil por nombre y verificar su suma
+    const PerfilBinario& buscar(const std::string& nombre) const {
+        for (uint32_t k = 0; k < cantidad; ++k) {
+            if (nombre == std::string(perfiles[k].nombre, strnlen(perfiles[k].nombre, sizeof(perfiles[k].nombre)))) {
+                if (sumaPerfil(perfiles[k]) != perfiles[k].suma) {
+                    throw std::runtime_error("El perfil '" + nombre + "' está corrupto (suma de verificación)");
+                }
+                return perfiles[k];
+            }
+        }
+        throw std::runtime_error("No existe el perfil: " + nombre);
+    }
+
+    // Copiar un perfil a las tablas globales (cambiar de modelo de costos sin leer texto)
+    void usar(const std::string& nombre) const {
+        const PerfilBinario& perfil = buscar(nombre);
+        for (int a = 0; a < ALPHABET_SIZE; ++a) {
+            cost_insert_table[a] = perfil.insertar[a];
+            cost_delete_table[a] = perfil.eliminar[a];
+            for (int b = 0; b < ALPHABET_SIZE; ++b) {
+                cost_matrix[a][b] = perfil.sustituir[a][b];
+                cost_transpose_matrix[a][b] = perfil.transponer[a][b];
+            }
+        }
+    }
+
+    uint32_t cantidad = 0;
+    const PerfilBinario* perfiles = nullptr;
+
+private:
+    const unsigned char* datos = nullptr;
+    size_t tamano = 0;
+};
+
+// Leer exactamente 'cantidad' enteros no negativos de un archivo de texto. A diferencia de los
+// cargadores de arriba, cualquier problema (archivo que falta, valores de menos o de más, valores
+// negativos) es un error.
+std::vector<int32_t> leerValoresEstricto(const std::string& ruta, int cantidad) {
+    std::ifstream archivo(ruta);
+    if (!archivo.is_open()) {
+        throw std::runtime_error("Error al abrir el archivo: " + ruta);
+    }
+    std::vector<int32_t> valores(cantidad);
+    for (int k = 0; k < cantidad; ++k) {
+        if (!(archivo >> valores[k])) {
+            throw std::runtime_error("El archivo '" + ruta + "' debe tener " + std::to_string(cantidad) + " enteros");
+        }
+        if (valores[k] < 0) {
+            throw std::runtime_error("El archivo '" + ruta + "' tiene un costo negativo");
+        }
+    }
+    archivo >> std::ws;
+    if (!archivo.eof()) {
+        throw std::runtime_error("El archivo '" + ruta + "' tiene datos de más");
+    }
+    return valores;
+}
+
+// Compilar perfiles: cada perfil es un nombre y una carpeta con los cuatro archivos de texto
+// (cost_insert.txt, cost_delete.txt, cost_replace.txt y cost_transpose.txt)
+void compilarPerfiles(const std::string& salida, const std::vector<std::pair<std::string, std::string>>& entradas) {
+    std::vector<PerfilBinario> perfiles(entradas.size());
+    for (size_t k = 0; k < entradas.size(); ++k) {
+        const std::string& nombre = entradas[k].first;
+        const std::string& carpeta = entradas[k].second;
+        if (nombre.empty() || nombre.size() >= sizeof(PerfilBinario::nombre)) {
+            throw std::invalid_argument("Nombre de perfil inválido (1 a 31 caracteres): " + nombre);
+        }
+        for (size_t otro = 0; otro < k; ++otro) {
+            if (entradas[otro].first == nombre) {
+                throw std::invalid_argument("Perfil repetido: " + nombre);
+            }
+        }
+
+        PerfilBinario& perfil = perfiles[k];
+        std::memset(&perfil, 0, sizeof(perfil));
+        std::memcpy(perfil.nombre, nombre.data(), nombre.size());
+        std::vector<int32_t> ins = leerValoresEstricto(carpeta + "/cost_insert.txt", ALPHABET_SIZE);
+        std::vector<int32_t> del = leerValoresEstricto(carpeta + "/cost_delete.txt", ALPHABET_SIZE);
+        std::vector<int32_t> sub = leerValoresEstricto(carpeta + "/cost_replace.txt", ALPHABET_SIZE * ALPHABET_SIZE);
+        std::vector<int32_t> trans = leerValoresEstricto(carpeta + "/cost_transpose.txt", ALPHABET_SIZE * ALPHABET_SIZE);
+        std::memcpy(perfil.insertar, ins.data(), sizeof(perfil.insertar));
+        std::memcpy(perfil.eliminar, del.data(), sizeof(perfil.eliminar));
+        std::memcpy(perfil.sustituir, sub.data(), sizeof(perfil.sustituir));
+        std::memcpy(perfil.transponer, trans.data(), sizeof(perfil.transponer));
+        perfil.suma = sumaPerfil(perfil);
+    }
+
+    EncabezadoPerfiles encabezado;
+    std::memset(&encabezado, 0, sizeof(encabezado));
+    std::memcpy(encabezado.magia, MAGIA_PERFILES, sizeof(MAGIA_PERFILES));
+    encabezado.version = VERSION_PERFILES;
+    encabezado.cantidad = perfiles.size();
+    encabezado.alfabeto = ALPHABET_SIZE;
+
+    std::ofstream archivo(salida, std::ios::binary);
+    if (!archivo.is_open()) {
+        throw std::runtime_error("Error al abrir el archivo: " + salida);
+    }
+    archivo.write(reinterpret_cast<const char*>(&encabezado), sizeof(encabezado));
+    archivo.write(reinterpret_cast<const char*>(perfiles.data()), perfiles.size() * sizeof(PerfilBinario));
+    if (!archivo) {
+        throw std::runtime_error("Error al escribir el archivo: " + salida);
+    }
+    std::cout << "Se compilaron " << perfiles.size() << " perfiles en '" << salida << "'." << std::endl;
+}
+
 // Obtener el costo de sustituir el carácter 'a' por 'b'
 int costo_sub(char a, char b) {
     int index_a = tolower(a) - 'a';
@@ -110,26 +483,26 @@ int costo_sub(char a, char b) {
         throw std::invalid_argument("Caracteres fuera del rango permitido");
     }
 
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_matrix[index_a][index_b];
 }
 
 // Obtener el costo de insertar el carácter 'b'
 int cost_ins(char b) {
-    if (!std::isalpha(b)) {
-        std::cerr << "El carácter '" << b << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument(std::string("El carácter '") + b + "' no es una letra válida.");
     }
 
     b = std::tolower(b);
     int index = b - 'a';
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_insert_table[index];
 }
 
 // Obtener el costo de transponer los caracteres 'a' y 'b'
 int cost_trans(char a, char b) {
-    if (!std::isalpha(a) || !std::isalpha(b)) {
-        std::cerr << "Uno o ambos caracteres no son letras válidas." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a)) || !std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument("Uno o ambos caracteres no son letras válidas.");
     }
 
     a = std::tolower(a);
@@ -137,18 +510,19 @@ int cost_trans(char a, char b) {
     int index_a = a - 'a';
     int index_b = b - 'a';
 
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_transpose_matrix[index_a][index_b];
 }
 
 // Obtener el costo de eliminar el carácter 'a'
 int cost_del(char a) {
-    if (!std::isalpha(a)) {
-        std::cerr << "El carácter '" << a << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a))) {
+        throw std::invalid_argument(std::string("El carácter '") + a + "' no es una letra válida.");
     }
 
     a = std::tolower(a);
     int index = a - 'a';
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_delete_table[index];
 }
 
@@ -156,7 +530,11 @@ int cost_del(char a) {
 int minEditDistance(const std::string& A, const std::string& B) {
     int m = A.size();
     int n = B.size();
+    METRICA_INICIO(inicioReserva);
     std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1, INT_MAX));
+    METRICA_FIN(inicioReserva, reservaNs);
+    METRICA_SUMAR(bytesDp, (m + 1ULL) * ((n + 1) * sizeof(int) + sizeof(std::vector<int>)));
+    METRICA_INICIO(inicioLlenado);
 
     // Inicializar la primera fila y columna (costos acumulados de inserción/eliminación)
     dp[0][0] = 0;
@@ -180,18 +558,4153 @@ int minEditDistance(const std::string& A, const std::string& B) {
             }
         }
     }
+    METRICA_FIN(inicioLlenado, llenadoNs);
+    METRICA_SUMAR(celdas, 1ULL * m * n);
 
     return dp[m][n];
 }
 
-// Función principal
-int main() {
-    try {
-        // Cargar las tablas y matrices de costos desde archivos
-        cargar_matriz_costos("cost_replace.txt");
-        cargarTablaCostos("cost_insert.txt");
-        cargarTablaCostosEliminacion("cost_delete.txt");
-        cargarMatrizCostosTransposicion("cost_transpose.txt");
+// Calcular la distancia mínima de edición usando memoria lineal O(min(m, n))
+// Solo se guardan tres filas (la transposición mira dos filas hacia atrás) en un único buffer
+// contiguo, y la cadena más corta se recorre en el eje interno.
+int minEditDistanceLineal(const std::string& A, const std::string& B) {
+    int m = A.size();
+    int n = B.size();
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    METRICA_SUMAR(bytesDp, 3ULL * (std::min(m, n) + 1) * sizeof(int));
+
+    if (n <= m) {
+        // Filas sobre A, columnas sobre B (mismo orden que minEditDistance)
+        std::vector<int> buffer(3 * (n + 1));
+        int* previa2 = buffer.data();          // fila i - 2
+        int* previa = buffer.data() + (n + 1);  // fila i - 1
+        int* actual = buffer.data() + 2 * (n + 1); // fila i
+
+        previa[0] = 0;
+        for (int j = 1; j <= n; ++j) {
+            previa[j] = previa[j - 1] + cost_ins(B[j - 1]);
+        }
+
+        for (int i = 1; i <= m; ++i) {
+            actual[0] = previa[0] + cost_del(A[i - 1]);
+            for (int j = 1; j <= n; ++j) {
+                int valor = actual[j - 1] + cost_ins(B[j - 1]); // Inserción
+                valor = std::min(valor, previa[j] + cost_del(A[i - 1])); // Eliminación
+                valor = std::min(valor, previa[j - 1] + costo_sub(A[i - 1], B[j - 1])); // Sustitución
+
+                // Transposición (si aplica)
+                if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
+                    valor = std::min(valor, previa2[j - 2] + cost_trans(A[i - 1], A[i - 2]));
+                }
+                actual[j] = valor;
+            }
+            // Rotar las filas sin copiar
+            int* libre = previa2;
+            previa2 = previa;
+            previa = actual;
+            actual = libre;
+        }
+        return previa[n];
+    }
+
+    // Columnas sobre B, filas sobre A (A es la más corta y queda en el eje interno)
+    std::vector<int> buffer(3 * (m + 1));
+    int* previa2 = buffer.data();          // columna j - 2
+    int* previa = buffer.data() + (m + 1);  // columna j - 1
+    int* actual = buffer.data() + 2 * (m + 1); // columna j
+
+    previa[0] = 0;
+    for (int i = 1; i <= m; ++i) {
+        previa[i] = previa[i - 1] + cost_del(A[i - 1]);
+    }
+
+    for (int j = 1; j <= n; ++j) {
+        actual[0] = previa[0] + cost_ins(B[j - 1]);
+        for (int i = 1; i <= m; ++i) {
+            int valor = previa[i] + cost_ins(B[j - 1]); // Inserción
+            valor = std::min(valor, actual[i - 1] + cost_del(A[i - 1])); // Eliminación
+            valor = std::min(valor, previa[i - 1] + costo_sub(A[i - 1], B[j - 1])); // Sustitución
+
+            // Transposición (si aplica)
+            if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
+                valor = std::min(valor, previa2[i - 2] + cost_trans(A[i - 1], A[i - 2]));
+            }
+            actual[i] = valor;
+        }
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+    return previa[m];
+}
+
+// Convertir una cadena a índices del alfabeto (0..25), validando cada carácter una sola vez
+// (versión que escribe en un arreglo ya reservado de cadena.size() enteros)
+void codificarCadena(const std::string& cadena, int* codigos) {
+    for (size_t k = 0; k < cadena.size(); ++k) {
+        unsigned char c = static_cast<unsigned char>(cadena[k]);
+        if (!std::isalpha(c)) {
+            throw std::invalid_argument("El carácter '" + std::string(1, cadena[k]) + "' no es una letra válida.");
+        }
+        codigos[k] = std::tolower(c) - 'a';
+    }
+}
+
+// (versión que reutiliza el vector de salida)
+void codificarCadena(const std::string& cadena, std::vector<int>& codigos) {
+    codigos.resize(cadena.size());
+    codificarCadena(cadena, codigos.data());
+}
+
+std::vector<int> codificarCadena(const std::string& cadena) {
+    std::vector<int> codigos;
+    codificarCadena(cadena, codigos);
+    return codigos;
+}
+
+// Memoria de trabajo de los motores rápidos (minEditDistanceRapida, distanciaBitsUnitaria y
+// minEditDistanceAuto). Se puede reutilizar entre llamadas (por ejemplo, una por hebra en el modo
+// por lotes) para no pedir memoria en cada par: es un solo buffer contiguo que solo crece. Cada
+// llamada pide con preparar() el total que va a usar y luego lo reparte con tomar(); solo se pide
+// memoria al sistema cuando el total supera lo que ya se tiene.
+class MemoriaRapida {
+public:
+    // Bytes que ocupa un arreglo de 'cantidad' elementos dentro del buffer (múltiplo de 8, para
+    // que todos los arreglos queden alineados para uint64_t)
+    template <typename T>
+    static size_t bytesPara(size_t cantidad) {
+        return (cantidad * sizeof(T) + 7) / 8 * 8;
+    }
+
+    // Dejar al menos 'bytes' disponibles y volver al comienzo del buffer. Los arreglos entregados
+    // antes dejan de ser válidos.
+    void preparar(size_t bytes) {
+        size_t palabras = (bytes + 7) / 8;
+        if (palabras > capacidadPalabras) {
+            METRICA_SUMAR(bytesDp, (palabras - capacidadPalabras) * 8);
+            buffer.reset(new uint64_t[palabras]);
+            capacidadPalabras = palabras;
+            ++crecimientos;
+        }
+        usado = 0;
+    }
+
+    // Tomar un arreglo de 'cantidad' elementos (sin inicializar) de lo preparado
+    template <typename T>
+    T* tomar(size_t cantidad) {
+        T* arreglo = reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(buffer.get()) + usado);
+        usado += bytesPara<T>(cantidad);
+        if (usado > capacidadPalabras * 8) {
+            throw std::logic_error("MemoriaRapida: se tomó más de lo preparado");
+        }
+        return arreglo;
+    }
+
+    size_t capacidad() const {
+        return capacidadPalabras * 8;
+    }
+
+    long long crecimientos = 0; // veces que se pidió memoria al sistema
+    std::string parteA, parteB;  // lo que queda de A y B después de la etapa de reducción
+
+private:
+    std::unique_ptr<uint64_t[]> buffer;
+    size_t capacidadPalabras = 0;
+    size_t usado = 0;
+};
+
+// Distancia mínima de edición con los costos pre-codificados (camino rápido)
+// A y B se validan y codifican una vez; cada fila toma su fila de cost_matrix y su costo de
+// eliminación, y los costos de inserción de B quedan en un arreglo. El ciclo interno no llama
+// funciones y solo tiene la comparación de la transposición.
+int minEditDistanceRapida(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    int m = A.size();
+    int n = B.size();
+
+    METRICA_INICIO(inicioReserva);
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + 2 * MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(3 * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* insB = memoria.tomar<int>(n);
+    int* filas = memoria.tomar<int>(3 * (n + 1));
+    METRICA_FIN(inicioReserva, reservaNs);
+
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    for (int j = 0; j < n; ++j) {
+        insB[j] = cost_insert_table[codB[j]];
+    }
+
+    METRICA_INICIO(inicioLlenado);
+    int* previa2 = filas;
+    int* previa = filas + (n + 1);
+    int* actual = filas + 2 * (n + 1);
+
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = previa[j - 1] + insB[j - 1];
+    }
+
+    for (int i = 1; i <= m; ++i) {
+        const int* filaSub = cost_matrix[codA[i - 1]].data();
+        const int borrar = cost_delete_table[codA[i - 1]];
+        const char a = A[i - 1];
+        // Con i == 1 no hay transposición: '\0' nunca coincide con una letra de B
+        const char aPrevia = i > 1 ? A[i - 2] : '\0';
+        const int trans = i > 1 ? cost_transpose_matrix[codA[i - 1]][codA[i - 2]] : 0;
+
+        actual[0] = previa[0] + borrar;
+        if (n >= 1) {
+            actual[1] = std::min({actual[0] + insB[0], previa[1] + borrar, previa[0] + filaSub[codB[0]]});
+        }
+        for (int j = 2; j <= n; ++j) {
+            int valor = std::min(actual[j - 1] + insB[j - 1], previa[j] + borrar);
+            valor = std::min(valor, previa[j - 1] + filaSub[codB[j - 1]]);
+            if (a == B[j - 2] && aPrevia == B[j - 1]) {
+                valor = std::min(valor, previa2[j - 2] + trans);
+            }
+            actual[j] = valor;
+        }
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+    METRICA_FIN(inicioLlenado, llenadoNs);
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    return previa[n];
+}
+
+int minEditDistanceRapida(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return minEditDistanceRapida(A, B, memoria);
+}
+
+// Distancia de costo unitario con transposiciones (alineamiento óptimo de cadenas) con vectores de
+// bits, algoritmo de Hyyrö (2003) sobre el de Myers. A va en los bits (64 filas por palabra, varias
+// palabras si A es más larga) y B se recorre columna por columna. Las sumas y desplazamientos se
+// propagan entre palabras, así que el resultado es el mismo que con una sola palabra de |A| bits.
+// A y B deben estar en minúsculas (la transposición compara caracteres tal cual).
+int distanciaBitsUnitaria(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    int m = A.size();
+    int n = B.size();
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    if (m == 0) {
+        return n;
+    }
+
+    int palabras = (m + 63) / 64;
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<uint64_t>((ALPHABET_SIZE + 4) * palabras));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+
+    // Peq[letra * palabras + p]: bits de las filas de A donde aparece la letra
+    uint64_t* Peq = memoria.tomar<uint64_t>(ALPHABET_SIZE * palabras);
+    std::fill(Peq, Peq + ALPHABET_SIZE * palabras, 0);
+    for (int i = 0; i < m; ++i) {
+        Peq[codA[i] * palabras + i / 64] |= uint64_t(1) << (i % 64);
+    }
+    uint64_t* VP = memoria.tomar<uint64_t>(palabras);
+    uint64_t* VN = memoria.tomar<uint64_t>(palabras);
+    uint64_t* D0 = memoria.tomar<uint64_t>(palabras);
+    uint64_t* PMprevia = memoria.tomar<uint64_t>(palabras);
+    std::fill(VP, VP + palabras, ~uint64_t(0));
+    std::fill(VN, VN + palabras, 0);
+    std::fill(D0, D0 + palabras, 0);
+    std::fill(PMprevia, PMprevia + palabras, 0);
+    const uint64_t bitUltimo = uint64_t(1) << ((m - 1) % 64);
+    int puntaje = m;
+
+    for (int j = 0; j < n; ++j) {
+        const uint64_t* PMcolumna = &Peq[codB[j] * palabras];
+        uint64_t acarreoSuma = 0, acarreoTR = 0, acarreoHP = 1, acarreoHN = 0;
+        for (int p = 0; p < palabras; ++p) {
+            uint64_t PM = PMcolumna[p];
+            uint64_t vp = VP[p], vn = VN[p];
+
+            // Transposición: A[i] = B[j - 1] y A[i - 1] = B[j] sin coincidencia diagonal previa
+            uint64_t candidatos = ~D0[p] & PM;
+            uint64_t TR = ((candidatos << 1) | acarreoTR) & PMprevia[p];
+            acarreoTR = candidatos >> 63;
+
+            uint64_t X = PM & vp;
+            uint64_t suma = X + vp;
+            uint64_t acarreo = suma < X;
+            suma += acarreoSuma;
+            acarreo |= suma < acarreoSuma;
+            acarreoSuma = acarreo;
+
+            uint64_t d0 = (suma ^ vp) | PM | vn | TR;
+            uint64_t HP = vn | ~(d0 | vp);
+            uint64_t HN = d0 & vp;
+            if (p == palabras - 1) {
+                if (HP & bitUltimo) {
+                    ++puntaje;
+                } else if (HN & bitUltimo) {
+                    --puntaje;
+                }
+            }
+            uint64_t HPdesplazado = (HP << 1) | acarreoHP;
+            uint64_t HNdesplazado = (HN << 1) | acarreoHN;
+            acarreoHP = HP >> 63;
+            acarreoHN = HN >> 63;
+
+            VP[p] = HNdesplazado | ~(d0 | HPdesplazado);
+            VN[p] = HPdesplazado & d0;
+            D0[p] = d0;
+            PMprevia[p] = PM;
+        }
+    }
+    return puntaje;
+}
+
+int distanciaBitsUnitaria(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return distanciaBitsUnitaria(A, B, memoria);
+}
+
+// Motor con celdas angostas. Borrar A completa e insertar B completa es un camino válido, así que
+// ninguna celda dp[i][j] supera (costo de borrar A[0, i)) + (costo de insertar B[0, j)), y ningún
+// candidato del mínimo supera eso más el costo de una operación. Con esa cota se elige el ancho de
+// las celdas: 16 bits si cabe, 32 si no, y un error si ni siquiera cabe en int (nunca se devuelve
+// una suma desbordada). Las sumas son saturadas (el máximo del tipo es el infinito), aunque con la
+// cota elegida no llegan a saturar. Todo esto supone costos no negativos; si hay alguno negativo
+// se usan celdas de 32 bits con una cota de la magnitud (ver anchoCeldas).
+//
+// Cada fila se llena en dos pasadas: primero eliminación, sustitución y transposición, que solo
+// leen las filas anteriores y se calculan con SIMD (con 16 bits caben 8 celdas en SSE2 y 16 en
+// AVX2, el doble que con int), y después la inserción, que depende de la celda de la izquierda.
+// Los costos de sustitución se leen de un perfil por letra de A (cost_matrix[letra][B[j]] contiguo
+// en j), armado la primera vez que aparece cada letra.
+
+// Suma saturada de una celda y un costo no negativo
+inline int16_t sumaSaturada(int16_t a, int b) {
+    int suma = a + b; // sin desborde: con celdas de 16 bits los costos también caben en 16 bits
+    return static_cast<int16_t>(std::min(suma, static_cast<int>(std::numeric_limits<int16_t>::max())));
+}
+
+inline int32_t sumaSaturada(int32_t a, int b) {
+    int32_t suma;
+    return __builtin_add_overflow(a, b, &suma) ? std::numeric_limits<int32_t>::max() : suma;
+}
+
+// Datos de la primera pasada de la fila i (índices j de 0 a n)
+template <typename Celda>
+struct FilaAngosta {
+    int n;
+    const Celda* previa;  // fila i - 1
+    const Celda* previa2; // fila i - 2
+    const Celda* filaSub; // filaSub[j - 1] = costo de sustituir A[i - 1] por B[j - 1]
+    const char* b;        // B
+    Celda borrar;         // costo de eliminar A[i - 1]
+    Celda trans;          // costo de transponer A[i - 2]A[i - 1]
+    char a;               // A[i - 1]
+    char aPrevia;         // A[i - 2], '\0' si i == 1 (nunca coincide con una letra de B)
+    Celda* parcial;       // salida
+};
+
+// Primera pasada para las columnas desde..n, una a la vez (respaldo sin SIMD y colas)
+template <typename Celda>
+void pasadaAngostaEscalar(const FilaAngosta<Celda>& F, int desde) {
+    for (int j = desde; j <= F.n; ++j) {
+        Celda valor = std::min(sumaSaturada(F.previa[j], F.borrar), sumaSaturada(F.previa[j - 1], F.filaSub[j - 1]));
+        if (F.a == F.b[j - 2] && F.aPrevia == F.b[j - 1]) {
+            valor = std::min(valor, sumaSaturada(F.previa2[j - 2], F.trans));
+        }
+        F.parcial[j] = valor;
+    }
+}
+
+#ifdef DP_SIMD_X86
+// 16 celdas de 16 bits por iteración (sumas saturadas con _mm256_adds_epi16)
+__attribute__((target("avx2")))
+void pasadaAngostaAVX2(const FilaAngosta<int16_t>& F, int desde) {
+    const __m256i borrar = _mm256_set1_epi16(F.borrar);
+    const __m256i trans = _mm256_set1_epi16(F.trans);
+    const __m128i a = _mm_set1_epi8(F.a);
+    const __m128i aPrevia = _mm_set1_epi8(F.aPrevia);
+    int j = desde;
+    for (; j + 15 <= F.n; j += 16) {
+        __m256i del = _mm256_adds_epi16(_mm256_loadu_si256((const __m256i*)(F.previa + j)), borrar);
+        __m256i sub = _mm256_adds_epi16(_mm256_loadu_si256((const __m256i*)(F.previa + j - 1)),
+                                        _mm256_loadu_si256((const __m256i*)(F.filaSub + j - 1)));
+        __m256i valor = _mm256_min_epi16(del, sub);
+        __m128i aplica8 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(F.b + j - 2)), a),
+                                        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(F.b + j - 1)), aPrevia));
+        __m256i aplica = _mm256_cvtepi8_epi16(aplica8);
+        __m256i transpuesta = _mm256_adds_epi16(_mm256_loadu_si256((const __m256i*)(F.previa2 + j - 2)), trans);
+        valor = _mm256_blendv_epi8(valor, _mm256_min_epi16(valor, transpuesta), aplica);
+        _mm256_storeu_si256((__m256i*)(F.parcial + j), valor);
+    }
+    pasadaAngostaEscalar(F, j);
+}
+
+// 8 celdas de 16 bits por iteración; SSE2 está en todo procesador x86-64
+void pasadaAngostaSSE2(const FilaAngosta<int16_t>& F, int desde) {
+    const __m128i borrar = _mm_set1_epi16(F.borrar);
+    const __m128i trans = _mm_set1_epi16(F.trans);
+    const __m128i a = _mm_set1_epi8(F.a);
+    const __m128i aPrevia = _mm_set1_epi8(F.aPrevia);
+    int j = desde;
+    for (; j + 7 <= F.n; j += 8) {
+        __m128i del = _mm_adds_epi16(_mm_loadu_si128((const __m128i*)(F.previa + j)), borrar);
+        __m128i sub = _mm_adds_epi16(_mm_loadu_si128((const __m128i*)(F.previa + j - 1)),
+                                     _mm_loadu_si128((const __m128i*)(F.filaSub + j - 1)));
+        __m128i valor = _mm_min_epi16(del, sub);
+        __m128i aplica8 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadl_epi64((const __m128i*)(F.b + j - 2)), a),
+                                        _mm_cmpeq_epi8(_mm_loadl_epi64((const __m128i*)(F.b + j - 1)), aPrevia));
+        __m128i aplica = _mm_unpacklo_epi8(aplica8, aplica8); // cada byte 0x00/0xFF pasa a 16 bits
+        __m128i transpuesta = _mm_adds_epi16(_mm_loadu_si128((const __m128i*)(F.previa2 + j - 2)), trans);
+        __m128i minimo = _mm_min_epi16(valor, transpuesta);
+        valor = _mm_or_si128(_mm_and_si128(aplica, minimo), _mm_andnot_si128(aplica, valor));
+        _mm_storeu_si128((__m128i*)(F.parcial + j), valor);
+    }
+    pasadaAngostaEscalar(F, j);
+}
+#endif
+
+// Elegir la primera pasada de 16 bits según la CPU
+void (*elegirPasadaAngosta())(const FilaAngosta<int16_t>&, int) {
+#ifdef DP_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return pasadaAngostaAVX2;
+    }
+    return pasadaAngostaSSE2;
+#else
+    return pasadaAngostaEscalar<int16_t>;
+#endif
+}
+
+template <typename Celda>
+void primeraPasada(const FilaAngosta<Celda>& F, int desde) {
+    pasadaAngostaEscalar(F, desde);
+}
+
+template <>
+void primeraPasada<int16_t>(const FilaAngosta<int16_t>& F, int desde) {
+    static void (*const pasada)(const FilaAngosta<int16_t>&, int) = elegirPasadaAngosta();
+    pasada(F, desde);
+}
+
+// Costos de inserción de B para la segunda pasada: la versión serial usa el costo de cada letra y
+// la de mínimo prefijo, el acumulado
+template <typename Celda>
+struct InsercionesB {
+    const Celda* costo;     // costo[j - 1] = insertar B[j - 1]
+    const Celda* acumulado; // acumulado[j] = insertar B[0, j)
+};
+
+// Segunda pasada: actual[j] = min(parcial[j], actual[j - 1] + insertar B[j - 1])
+template <typename Celda>
+void segundaPasada(const Celda* parcial, const InsercionesB<Celda>& ins, int n, Celda* actual) {
+    actual[0] = parcial[0];
+    for (int j = 1; j <= n; ++j) {
+        actual[j] = std::min(parcial[j], sumaSaturada(actual[j - 1], ins.costo[j - 1]));
+    }
+}
+
+#ifdef DP_SIMD_X86
+// Con S[j] = costo de insertar B[0, j), la recurrencia queda actual[j] = S[j] + min(parcial[k] - S[k])
+// para k <= j: un mínimo prefijo, que se calcula de a 8 celdas con desplazamientos dentro del
+// registro en vez de una celda a la vez. Con la cota elegida ninguna de estas restas ni sumas
+// se sale de 16 bits.
+template <>
+void segundaPasada<int16_t>(const int16_t* parcial, const InsercionesB<int16_t>& ins, int n, int16_t* actual) {
+    const int16_t* S = ins.acumulado;
+    const int16_t maximo = std::numeric_limits<int16_t>::max();
+    const __m128i relleno1 = _mm_setr_epi16(maximo, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i relleno2 = _mm_setr_epi16(maximo, maximo, 0, 0, 0, 0, 0, 0);
+    const __m128i relleno4 = _mm_setr_epi16(maximo, maximo, maximo, maximo, 0, 0, 0, 0);
+    __m128i arrastre = _mm_set1_epi16(maximo);
+    int j = 0;
+    for (; j + 7 <= n; j += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(S + j));
+        __m128i x = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)(parcial + j)), s);
+        x = _mm_min_epi16(x, _mm_or_si128(_mm_slli_si128(x, 2), relleno1));
+        x = _mm_min_epi16(x, _mm_or_si128(_mm_slli_si128(x, 4), relleno2));
+        x = _mm_min_epi16(x, _mm_or_si128(_mm_slli_si128(x, 8), relleno4));
+        x = _mm_min_epi16(x, arrastre);
+        _mm_storeu_si128((__m128i*)(actual + j), _mm_add_epi16(x, s));
+        __m128i ultimo = _mm_shufflehi_epi16(x, 0xFF);
+        arrastre = _mm_unpackhi_epi64(ultimo, ultimo);
+    }
+    int16_t minimo = static_cast<int16_t>(_mm_cvtsi128_si32(arrastre));
+    for (; j <= n; ++j) {
+        minimo = std::min(minimo, static_cast<int16_t>(parcial[j] - S[j]));
+        actual[j] = static_cast<int16_t>(minimo + S[j]);
+    }
+}
+
+// Lo mismo con celdas int, de a 4 (SSE2 no tiene mínimo de enteros de 32 bits: se arma con una
+// comparación). Con estas celdas no se acota la distancia, así que vale lo mismo que para el resto
+// de los motores con int: los costos acumulados deben caber en int.
+template <>
+void segundaPasada<int>(const int* parcial, const InsercionesB<int>& ins, int n, int* actual) {
+    const int* S = ins.acumulado;
+    auto minimo4 = [](__m128i x, __m128i y) {
+        __m128i mayor = _mm_cmpgt_epi32(x, y);
+        return _mm_or_si128(_mm_and_si128(mayor, y), _mm_andnot_si128(mayor, x));
+    };
+    const __m128i relleno1 = _mm_setr_epi32(INT_MAX, 0, 0, 0);
+    const __m128i relleno2 = _mm_setr_epi32(INT_MAX, INT_MAX, 0, 0);
+    __m128i arrastre = _mm_set1_epi32(INT_MAX);
+    int j = 0;
+    for (; j + 3 <= n; j += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(S + j));
+        __m128i x = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(parcial + j)), s);
+        x = minimo4(x, _mm_or_si128(_mm_slli_si128(x, 4), relleno1));
+        x = minimo4(x, _mm_or_si128(_mm_slli_si128(x, 8), relleno2));
+        x = minimo4(x, arrastre);
+        _mm_storeu_si128((__m128i*)(actual + j), _mm_add_epi32(x, s));
+        arrastre = _mm_shuffle_epi32(x, 0xFF);
+    }
+    int menor = _mm_cvtsi128_si32(arrastre);
+    for (; j <= n; ++j) {
+        menor = std::min(menor, parcial[j] - S[j]);
+        actual[j] = menor + S[j];
+    }
+}
+#endif
+
+template <typename Celda>
+int llenarFilasAngostas(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    const int m = A.size();
+    const int n = B.size();
+
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<Celda>(static_cast<size_t>(ALPHABET_SIZE) * n) +
+                     MemoriaRapida::bytesPara<Celda>(n) + MemoriaRapida::bytesPara<Celda>(n + 1) +
+                     MemoriaRapida::bytesPara<Celda>(4 * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    Celda* perfil = memoria.tomar<Celda>(static_cast<size_t>(ALPHABET_SIZE) * n);
+    Celda* insB = memoria.tomar<Celda>(n);
+    Celda* acumuladoIns = memoria.tomar<Celda>(n + 1);
+    Celda* filas = memoria.tomar<Celda>(4 * (n + 1));
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    for (int j = 0; j < n; ++j) {
+        insB[j] = static_cast<Celda>(cost_insert_table[codB[j]]);
+    }
+    bool perfilListo[ALPHABET_SIZE] = {};
+
+    Celda* previa2 = filas;
+    Celda* previa = filas + (n + 1);
+    Celda* actual = filas + 2 * (n + 1);
+    Celda* parcial = filas + 3 * (n + 1);
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = sumaSaturada(previa[j - 1], insB[j - 1]);
+    }
+    std::copy(previa, previa + n + 1, acumuladoIns);
+    const InsercionesB<Celda> inserciones{insB, acumuladoIns};
+
+    for (int i = 1; i <= m; ++i) {
+        const int letra = codA[i - 1];
+        Celda* filaSub = perfil + static_cast<size_t>(letra) * n;
+        if (!perfilListo[letra]) {
+            for (int j = 0; j < n; ++j) {
+                filaSub[j] = static_cast<Celda>(cost_matrix[letra][codB[j]]);
+            }
+            perfilListo[letra] = true;
+        }
+        FilaAngosta<Celda> F;
+        F.n = n;
+        F.previa = previa;
+        F.previa2 = previa2;
+        F.filaSub = filaSub;
+        F.b = B.data();
+        F.borrar = static_cast<Celda>(cost_delete_table[letra]);
+        F.trans = static_cast<Celda>(i > 1 ? cost_transpose_matrix[letra][codA[i - 2]] : 0);
+        F.a = A[i - 1];
+        F.aPrevia = i > 1 ? A[i - 2] : '\0';
+        F.parcial = parcial;
+
+        // Pasada 1: las columnas 0 y 1 no tienen transposición
+        parcial[0] = sumaSaturada(previa[0], F.borrar);
+        if (n >= 1) {
+            parcial[1] = std::min(sumaSaturada(previa[1], F.borrar), sumaSaturada(previa[0], filaSub[0]));
+        }
+        primeraPasada(F, 2);
+
+        // Pasada 2: inserción desde la izquierda
+        segundaPasada(parcial, inserciones, n, actual);
+
+        Celda* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    if (previa[n] == std::numeric_limits<Celda>::max()) {
+        throw std::overflow_error("La distancia saturó las celdas del DP");
+    }
+    return previa[n];
+}
+
+// Cota superior de cualquier valor que aparece en el DP de A contra B (ver llenarFilasAngostas).
+// Las cadenas deben ser válidas (se codifican después).
+long long cotaCeldas(const std::string& A, const std::string& B) {
+    long long cota = 0;
+    for (char c : A) {
+        unsigned char u = static_cast<unsigned char>(c);
+        cota += std::isalpha(u) ? cost_delete_table[std::tolower(u) - 'a'] : 0;
+    }
+    for (char c : B) {
+        unsigned char u = static_cast<unsigned char>(c);
+        cota += std::isalpha(u) ? cost_insert_table[std::tolower(u) - 'a'] : 0;
+    }
+    int mayorOperacion = std::max(*std::max_element(cost_insert_table.begin(), cost_insert_table.end()),
+                                  *std::max_element(cost_delete_table.begin(), cost_delete_table.end()));
+    for (int x = 0; x < ALPHABET_SIZE; ++x) {
+        mayorOperacion = std::max(mayorOperacion, *std::max_element(cost_matrix[x].begin(), cost_matrix[x].end()));
+        mayorOperacion = std::max(mayorOperacion, *std::max_element(cost_transpose_matrix[x].begin(), cost_transpose_matrix[x].end()));
+    }
+    return cota + mayorOperacion;
+}
+
+// Ancho en bits de las celdas que usaría minEditDistanceAngosta (0 si la distancia no cabe en int)
+int anchoCeldas(const std::string& A, const std::string& B) {
+    if (costos_negativos) {
+        // Las celdas de 16 bits suponen costos no negativos (la saturación solo mira hacia arriba
+        // y el mínimo prefijo resta acumulados sin acotar por abajo). Con negativos se usan 32
+        // bits si alcanzan: cada celda, candidato o resta del mínimo prefijo es una suma de a lo
+        // más 2 * (m + n + 1) costos.
+        long long mayor = 0;
+        for (int x = 0; x < ALPHABET_SIZE; ++x) {
+            mayor = std::max({mayor, std::llabs(cost_insert_table[x]), std::llabs(cost_delete_table[x])});
+            for (int y = 0; y < ALPHABET_SIZE; ++y) {
+                mayor = std::max({mayor, std::llabs(cost_matrix[x][y]), std::llabs(cost_transpose_matrix[x][y])});
+            }
+        }
+        long long magnitud = 2 * (static_cast<long long>(A.size()) + static_cast<long long>(B.size()) + 1) * mayor;
+        return magnitud < std::numeric_limits<int32_t>::max() ? 32 : 0;
+    }
+    long long cota = cotaCeldas(A, B);
+    if (cota < std::numeric_limits<int16_t>::max()) {
+        return 16;
+    }
+    if (cota < std::numeric_limits<int32_t>::max()) {
+        return 32;
+    }
+    return 0;
+}
+
+int minEditDistanceAngosta(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    switch (anchoCeldas(A, B)) {
+        case 16:
+            return llenarFilasAngostas<int16_t>(A, B, memoria);
+        case 32:
+            return llenarFilasAngostas<int32_t>(A, B, memoria);
+        default:
+            throw std::overflow_error("La distancia entre las cadenas podría superar el rango de int");
+    }
+}
+
+int minEditDistanceAngosta(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return minEditDistanceAngosta(A, B, memoria);
+}
+
+// Políticas de costos para minEditDistance<Costos>. Cada política da los costos por código de letra
+// (0..25) y dice si la transposición compara las letras sin distinguir mayúsculas. CostosTablas lee
+// las tablas globales que llenan los cargadores (el caso general); las demás son modelos fijos con
+// tablas constexpr, así el compilador puede plegar las constantes y quitar las lecturas de memoria.
+struct CostosTablas {
+    static constexpr bool ignorarMayusculas = false;
+    static int insertar(int b) { return cost_insert_table[b]; }
+    static int eliminar(int a) { return cost_delete_table[a]; }
+    static int sustituir(int a, int b) { return cost_matrix[a][b]; }
+    static int transponer(int a, int aPrevia) { return cost_transpose_matrix[a][aPrevia]; }
+};
+
+// Levenshtein con transposiciones: todo cuesta 1 y sustituir una letra por sí misma, 0
+struct CostosUnitarios {
+    static constexpr bool ignorarMayusculas = false;
+    static constexpr int insertar(int) { return 1; }
+    static constexpr int eliminar(int) { return 1; }
+    static constexpr int sustituir(int a, int b) { return a == b ? 0 : 1; }
+    static constexpr int transponer(int, int) { return 1; }
+};
+
+// Distancia de teclado QWERTY: sustituir por una tecla vecina cuesta 1 y por cualquier otra 2;
+// insertar y eliminar cuestan 2 y transponer 1 (los errores de tipeo más comunes son los baratos)
+constexpr std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> armarCostosTeclado() {
+    const char* filas[3] = {"qwertyuiop", "asdfghjkl", "zxcvbnm"};
+    int fila[ALPHABET_SIZE] = {};
+    int columna[ALPHABET_SIZE] = {};
+    for (int f = 0; f < 3; ++f) {
+        for (int c = 0; filas[f][c] != '\0'; ++c) {
+            fila[filas[f][c] - 'a'] = f;
+            columna[filas[f][c] - 'a'] = c;
+        }
+    }
+    std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> costos{};
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            // Cada fila está corrida media tecla a la derecha de la de arriba: la tecla c de una
+            // fila toca las teclas c y c + 1 de la fila de arriba
+            int dc = columna[b] - columna[a];
+            bool vecinas = (fila[a] == fila[b] && (dc == 1 || dc == -1)) ||
+                           (fila[b] == fila[a] - 1 && (dc == 0 || dc == 1)) ||
+                           (fila[b] == fila[a] + 1 && (dc == 0 || dc == -1));
+            costos[a][b] = a == b ? 0 : (vecinas ? 1 : 2);
+        }
+    }
+    return costos;
+}
+
+struct CostosTeclado {
+    static constexpr bool ignorarMayusculas = false;
+    static constexpr std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> tabla = armarCostosTeclado();
+    static constexpr int insertar(int) { return 2; }
+    static constexpr int eliminar(int) { return 2; }
+    static constexpr int sustituir(int a, int b) { return tabla[a][b]; }
+    static constexpr int transponer(int, int) { return 1; }
+};
+
+// Los mismos costos de otra política, pero "Ab" y "bA" también cuentan como transposición. Los
+// costos ya se buscan por la letra en minúscula, así que solo cambia esa comparación.
+template <typename Costos>
+struct SinMayusculas : Costos {
+    static constexpr bool ignorarMayusculas = true;
+};
+
+// Primera pasada de la fila de minEditDistance<Costos> (columnas 2..n). Los punteros son
+// __restrict para que el compilador no tenga que verificar en tiempo de ejecución que no se
+// solapan, y con -O2 GCC solo vectoriza ciclos sin resto de iteraciones salvo que se le pida el
+// modelo de costo dinámico (el de -O3) para esta función. La transposición compara caracteres tal
+// cual, o los códigos (en minúscula) si la política ignora las mayúsculas.
+template <typename Costos, bool conTransposicion>
+__attribute__((optimize("vect-cost-model=dynamic")))
+void pasadaPolitica(const int* __restrict previa, const int* __restrict previa2, const int* __restrict codB,
+                    const char* __restrict b, int a, int aPrevia, char letra, char letraPrevia, int trans,
+                    int borrar, int n, int* __restrict parcial) {
+    for (int j = 2; j <= n; ++j) {
+        int valor = std::min(previa[j] + borrar, previa[j - 1] + Costos::sustituir(a, codB[j - 1]));
+        if (conTransposicion) {
+            bool aplica = Costos::ignorarMayusculas ? (a == codB[j - 2]) & (aPrevia == codB[j - 1])
+                                                    : (letra == b[j - 2]) & (letraPrevia == b[j - 1]);
+            int transpuesta = previa2[j - 2] + trans; // se lee siempre para que el ciclo no tenga saltos
+            valor = std::min(valor, aplica ? transpuesta : INT_MAX);
+        }
+        parcial[j] = valor;
+    }
+}
+
+// Distancia mínima de edición con una política de costos fija al compilar. Cada fila se llena en dos
+// pasadas, como en minEditDistanceAngosta: eliminación, sustitución y transposición (que solo leen
+// filas anteriores, así que con costos constantes el compilador la vectoriza) y después la
+// inserción, que depende de la celda de la izquierda.
+template <typename Costos = CostosTablas>
+int minEditDistance(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    int m = A.size();
+    int n = B.size();
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + 2 * MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(n + 1) + MemoriaRapida::bytesPara<int>(4 * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* insB = memoria.tomar<int>(n);
+    int* acumuladoIns = memoria.tomar<int>(n + 1);
+    int* filas = memoria.tomar<int>(4 * (n + 1));
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    for (int j = 0; j < n; ++j) {
+        insB[j] = Costos::insertar(codB[j]);
+    }
+
+    int* previa2 = filas;
+    int* previa = filas + (n + 1);
+    int* actual = filas + 2 * (n + 1);
+    int* parcial = filas + 3 * (n + 1);
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = previa[j - 1] + insB[j - 1];
+    }
+    std::copy(previa, previa + n + 1, acumuladoIns);
+    const InsercionesB<int> inserciones{insB, acumuladoIns};
+
+    for (int i = 1; i <= m; ++i) {
+        const int a = codA[i - 1];
+        const int borrar = Costos::eliminar(a);
+        parcial[0] = previa[0] + borrar;
+        if (n >= 1) {
+            parcial[1] = std::min(previa[1] + borrar, previa[0] + Costos::sustituir(a, codB[0]));
+        }
+        if (i == 1) {
+            pasadaPolitica<Costos, false>(previa, nullptr, codB, B.data(), a, 0, '\0', '\0', 0, borrar, n, parcial);
+        } else {
+            pasadaPolitica<Costos, true>(previa, previa2, codB, B.data(), a, codA[i - 2], A[i - 1], A[i - 2],
+                                         Costos::transponer(a, codA[i - 2]), borrar, n, parcial);
+        }
+        segundaPasada(parcial, inserciones, n, actual);
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    return previa[n];
+}
+
+template <typename Costos>
+int minEditDistance(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return minEditDistance<Costos>(A, B, memoria);
+}
+
+// Copiar los costos de una política a las tablas globales (para compararla con CostosTablas)
+template <typename Costos>
+void copiarCostosATablas() {
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        cost_insert_table[a] = Costos::insertar(a);
+        cost_delete_table[a] = Costos::eliminar(a);
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            cost_matrix[a][b] = Costos::sustituir(a, b);
+            cost_transpose_matrix[a][b] = Costos::transponer(a, b);
+        }
+    }
+}
+
+// Distancia con la etapa de reducción delante de 'motor': recorta el prefijo y el sufijo comunes y
+// resuelve en O(n) los casos triviales que quedan (una de las partes vacía, o una letra contra
+// una letra); el resto se lo pasa a 'motor'. La parte central se copia en parteA y parteB, que
+// conservan su capacidad entre llamadas.
+template <typename Motor>
+int minEditDistanceReducida(const std::string& A, const std::string& B, Motor motor, std::string& parteA,
+                            std::string& parteB) {
+    Recorte r = recortarComunes(A, B);
+    const int m = A.size() - r.prefijo - r.sufijo;
+    const int n = B.size() - r.prefijo - r.sufijo;
+    if (m == 0 || n == 0) {
+        int total = 0;
+        for (int k = 0; k < m; ++k) {
+            total += cost_del(A[r.prefijo + k]);
+        }
+        for (int k = 0; k < n; ++k) {
+            total += cost_ins(B[r.prefijo + k]);
+        }
+        return total;
+    }
+    if (m == 1 && n == 1) {
+        const char a = A[r.prefijo];
+        const char b = B[r.prefijo];
+        return std::min(costo_sub(a, b), cost_del(a) + cost_ins(b));
+    }
+    if (r.prefijo == 0 && r.sufijo == 0) {
+        return motor(A, B);
+    }
+    parteA.assign(A, r.prefijo, m);
+    parteB.assign(B, r.prefijo, n);
+    return motor(parteA, parteB);
+}
+
+template <typename Motor>
+int minEditDistanceReducida(const std::string& A, const std::string& B, Motor motor) {
+    std::string parteA, parteB;
+    return minEditDistanceReducida(A, B, motor, parteA, parteB);
+}
+
+// Distancia mínima de edición eligiendo el motor según las tablas cargadas: vectores de bits si los
+// costos son uniformes y las cadenas están en minúsculas, y el DP general en otro caso. Antes pasa
+// por la etapa de reducción.
+int minEditDistanceAuto(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    auto motor = [&memoria](const std::string& a, const std::string& b) {
+        if (costo_uniforme > 0) {
+            auto minuscula = [](char c) { return c >= 'a' && c <= 'z'; };
+            if (std::all_of(a.begin(), a.end(), minuscula) && std::all_of(b.begin(), b.end(), minuscula)) {
+                return costo_uniforme * distanciaBitsUnitaria(a, b, memoria);
+            }
+        }
+        return minEditDistanceRapida(a, b, memoria);
+    };
+    return minEditDistanceReducida(A, B, motor, memoria.parteA, memoria.parteB);
+}
+
+int minEditDistanceAuto(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return minEditDistanceAuto(A, B, memoria);
+}
+
+// Datos de una pasada por anti-diagonales. Todas las tablas están indexadas por i (fila de A),
+// de modo que las celdas de una misma diagonal quedan contiguas en memoria. B se guarda invertida
+// para que B[j - 1], con j = d - i, también avance de a uno cuando avanza i.
+struct DatosDiagonal {
+    int n; // largo de B
+    int d; // diagonal actual (i + j)
+    const char* aRelleno;     // aRelleno[i] = A[i - 1], aRelleno[0] = '\0'
+    const char* bInvertida;   // bInvertida[k] = B[n - 1 - k], bInvertida[n] = '\0'
+    const int* filaSubA;      // filaSubA[i] = índice de A[i - 1] * ALPHABET_SIZE
+    const int* codBInvertida; // codBInvertida[k] = índice de B[n - 1 - k]
+    const int* insBInvertida; // insBInvertida[k] = costo de insertar B[n - 1 - k]
+    const int* delA;          // delA[i] = costo de eliminar A[i - 1]
+    const int* transA;        // transA[i] = costo de transponer A[i - 2]A[i - 1]
+    const int* subPlana;      // cost_matrix como arreglo plano de 26 x 26
+    const int* diag1;         // diagonal d - 1
+    const int* diag2;         // diagonal d - 2
+    const int* diag4;         // diagonal d - 4
+    int* diagActual;          // diagonal d
+};
+
+// Llenar las celdas lo..hi de la diagonal d, una a la vez (respaldo sin SIMD)
+void diagonalEscalar(const DatosDiagonal& D, int lo, int hi) {
+    int desplazamiento = D.n - D.d; // k = i + desplazamiento es la posición de B[j - 1] en bInvertida
+    for (int i = lo; i <= hi; ++i) {
+        int k = i + desplazamiento;
+        int valor = D.diag1[i] + D.insBInvertida[k]; // Inserción
+        valor = std::min(valor, D.diag1[i - 1] + D.delA[i]); // Eliminación
+        valor = std::min(valor, D.diag2[i - 1] + D.subPlana[D.filaSubA[i] + D.codBInvertida[k]]); // Sustitución
+        // Transposición: los '\0' de relleno hacen fallar la comparación cuando i == 1 o j == 1
+        if (D.aRelleno[i] == D.bInvertida[k + 1] && D.aRelleno[i - 1] == D.bInvertida[k]) {
+            valor = std::min(valor, D.diag4[i - 2] + D.transA[i]);
+        }
+        D.diagActual[i] = valor;
+    }
+}
+
+#ifdef DP_SIMD_X86
+// Misma recurrencia que diagonalEscalar, 8 celdas por instrucción
+__attribute__((target("avx2")))
+void diagonalAVX2(const DatosDiagonal& D, int lo, int hi) {
+    int desplazamiento = D.n - D.d;
+    int i = lo;
+    for (; i + 7 <= hi; i += 8) {
+        int k = i + desplazamiento;
+        __m256i ins = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(D.diag1 + i)),
+                                       _mm256_loadu_si256((const __m256i*)(D.insBInvertida + k)));
+        __m256i del = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(D.diag1 + i - 1)),
+                                       _mm256_loadu_si256((const __m256i*)(D.delA + i)));
+        __m256i indices = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(D.filaSubA + i)),
+                                           _mm256_loadu_si256((const __m256i*)(D.codBInvertida + k)));
+        __m256i sub = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(D.diag2 + i - 1)),
+                                       _mm256_i32gather_epi32(D.subPlana, indices, 4));
+        __m256i valor = _mm256_min_epi32(_mm256_min_epi32(ins, del), sub);
+
+        long long bytes;
+        std::memcpy(&bytes, D.aRelleno + i, 8);
+        __m256i a = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(bytes));
+        std::memcpy(&bytes, D.aRelleno + i - 1, 8);
+        __m256i aPrevia = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(bytes));
+        std::memcpy(&bytes, D.bInvertida + k + 1, 8);
+        __m256i bPrevia = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(bytes));
+        std::memcpy(&bytes, D.bInvertida + k, 8);
+        __m256i b = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(bytes));
+        __m256i aplica = _mm256_and_si256(_mm256_cmpeq_epi32(a, bPrevia), _mm256_cmpeq_epi32(aPrevia, b));
+        __m256i trans = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(D.diag4 + i - 2)),
+                                         _mm256_loadu_si256((const __m256i*)(D.transA + i)));
+        valor = _mm256_blendv_epi8(valor, _mm256_min_epi32(valor, trans), aplica);
+
+        _mm256_storeu_si256((__m256i*)(D.diagActual + i), valor);
+    }
+    if (i <= hi) {
+        diagonalEscalar(D, i, hi);
+    }
+}
+
+// Misma recurrencia que diagonalEscalar, 4 celdas por instrucción (sin gather: la sustitución se
+// junta antes en un arreglo pequeño)
+__attribute__((target("sse4.1")))
+void diagonalSSE41(const DatosDiagonal& D, int lo, int hi) {
+    int desplazamiento = D.n - D.d;
+    int i = lo;
+    for (; i + 3 <= hi; i += 4) {
+        int k = i + desplazamiento;
+        alignas(16) int subJuntada[4];
+        for (int t = 0; t < 4; ++t) {
+            subJuntada[t] = D.subPlana[D.filaSubA[i + t] + D.codBInvertida[k + t]];
+        }
+        __m128i ins = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(D.diag1 + i)),
+                                    _mm_loadu_si128((const __m128i*)(D.insBInvertida + k)));
+        __m128i del = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(D.diag1 + i - 1)),
+                                    _mm_loadu_si128((const __m128i*)(D.delA + i)));
+        __m128i sub = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(D.diag2 + i - 1)),
+                                    _mm_load_si128((const __m128i*)subJuntada));
+        __m128i valor = _mm_min_epi32(_mm_min_epi32(ins, del), sub);
+
+        int bytes;
+        std::memcpy(&bytes, D.aRelleno + i, 4);
+        __m128i a = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+        std::memcpy(&bytes, D.aRelleno + i - 1, 4);
+        __m128i aPrevia = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+        std::memcpy(&bytes, D.bInvertida + k + 1, 4);
+        __m128i bPrevia = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+        std::memcpy(&bytes, D.bInvertida + k, 4);
+        __m128i b = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+        __m128i aplica = _mm_and_si128(_mm_cmpeq_epi32(a, bPrevia), _mm_cmpeq_epi32(aPrevia, b));
+        __m128i trans = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(D.diag4 + i - 2)),
+                                      _mm_loadu_si128((const __m128i*)(D.transA + i)));
+        valor = _mm_blendv_epi8(valor, _mm_min_epi32(valor, trans), aplica);
+
+        _mm_storeu_si128((__m128i*)(D.diagActual + i), valor);
+    }
+    if (i <= hi) {
+        diagonalEscalar(D, i, hi);
+    }
+}
+#endif
+
+// Elegir el núcleo de diagonales según la CPU en la que se ejecuta el programa
+void (*elegirNucleoDiagonal())(const DatosDiagonal&, int, int) {
+#ifdef DP_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return diagonalAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return diagonalSSE41;
+    }
+#endif
+    return diagonalEscalar;
+}
+
+// Nombre del núcleo elegido, para los experimentos
+std::string nombreNucleoDiagonal() {
+    auto nucleo = elegirNucleoDiagonal();
+#ifdef DP_SIMD_X86
+    if (nucleo == diagonalAVX2) return "AVX2";
+    if (nucleo == diagonalSSE41) return "SSE4.1";
+#endif
+    (void)nucleo;
+    return "escalar";
+}
+
+// Distancia mínima de edición recorriendo anti-diagonales (d = i + j) con SIMD.
+// Las celdas de una diagonal son independientes entre sí: dependen de las diagonales d - 1
+// (inserción y eliminación), d - 2 (sustitución) y d - 4 (transposición). El resultado es
+// idéntico al de minEditDistance para las tablas completas de 26 x 26.
+int minEditDistanceDiagonal(const std::string& A, const std::string& B) {
+    int m = A.size();
+    int n = B.size();
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    std::vector<int> codA = codificarCadena(A);
+    std::vector<int> codB = codificarCadena(B);
+
+    // Entradas preparadas una sola vez, indexadas como espera DatosDiagonal
+    std::vector<char> aRelleno(m + 1, '\0');
+    std::vector<char> bInvertida(n + 1, '\0');
+    std::vector<int> filaSubA(m + 1, 0), delA(m + 1, 0), transA(m + 1, 0);
+    std::vector<int> codBInvertida(n + 1, 0), insBInvertida(n + 1, 0);
+    for (int i = 1; i <= m; ++i) {
+        aRelleno[i] = A[i - 1];
+        filaSubA[i] = codA[i - 1] * ALPHABET_SIZE;
+        delA[i] = cost_delete_table[codA[i - 1]];
+        if (i > 1) {
+            transA[i] = cost_transpose_matrix[codA[i - 1]][codA[i - 2]];
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        bInvertida[k] = B[n - 1 - k];
+        codBInvertida[k] = codB[n - 1 - k];
+        insBInvertida[k] = cost_insert_table[codB[n - 1 - k]];
+    }
+
+    // Cinco diagonales (d, d - 1, ..., d - 4) en un solo buffer. Cada una tiene dos posiciones
+    // de relleno al inicio para que los accesos a i - 1 e i - 2 nunca salgan del buffer.
+    int ancho = m + 3;
+    std::vector<int> buffer(5 * ancho, INT_MAX);
+    int* diagonales[5];
+    for (int t = 0; t < 5; ++t) {
+        diagonales[t] = buffer.data() + t * ancho + 2;
+    }
+
+    DatosDiagonal D;
+    D.n = n;
+    D.aRelleno = aRelleno.data();
+    D.bInvertida = bInvertida.data();
+    D.filaSubA = filaSubA.data();
+    D.codBInvertida = codBInvertida.data();
+    D.insBInvertida = insBInvertida.data();
+    D.delA = delA.data();
+    D.transA = transA.data();
+    D.subPlana = cost_matrix[0].data();
+    auto nucleo = elegirNucleoDiagonal();
+
+    int bordeDel = 0; // dp[d][0]
+    int bordeIns = 0; // dp[0][d]
+    for (int d = 0; d <= m + n; ++d) {
+        // Rotar: la diagonal d - 4 que sale se reutiliza para la diagonal d
+        int* actual = diagonales[4];
+        for (int t = 4; t > 0; --t) {
+            diagonales[t] = diagonales[t - 1];
+        }
+        diagonales[0] = actual;
+
+        if (d > 0 && d <= m) bordeDel += delA[d];
+        if (d > 0 && d <= n) bordeIns += insBInvertida[n - d];
+        if (d <= n) actual[0] = bordeIns;
+        if (d <= m) actual[d] = bordeDel;
+
+        int lo = std::max(1, d - n);
+        int hi = std::min(m, d - 1);
+        if (lo <= hi) {
+            D.d = d;
+            D.diag1 = diagonales[1];
+            D.diag2 = diagonales[2];
+            D.diag4 = diagonales[4];
+            D.diagActual = actual;
+            nucleo(D, lo, hi);
+        }
+    }
+    return diagonales[0][m];
+}
+
+// Cola de bloques de un hilo del DP paralelo. El dueño saca por atrás y los demás hilos
+// roban por adelante.
+struct ColaBloques {
+    std::mutex candado;
+    std::deque<int> bloques;
+};
+
+// Distancia mínima de edición en paralelo por bloques (frente de onda).
+// La matriz se divide en bloques de 'tamBloque' x 'tamBloque'. Un bloque queda listo cuando
+// terminan el de arriba y el de la izquierda, y los hilos se reparten los bloques listos con robo
+// de trabajo. Entre bloques solo se intercambian bordes de dos filas / dos columnas (la
+// transposición mira dos celdas hacia atrás), así que la memoria extra es O(m + n).
+int minEditDistanceParalelo(const std::string& A, const std::string& B, int hilos, int tamBloque) {
+    int m = A.size();
+    int n = B.size();
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    std::vector<int> codA = codificarCadena(A);
+    std::vector<int> codB = codificarCadena(B);
+    if (hilos < 1 || tamBloque < 1) {
+        throw std::invalid_argument("La cantidad de hilos y el tamaño de bloque deben ser positivos");
+    }
+
+    if (m == 0 || n == 0) {
+        int total = 0;
+        for (int c : codA) total += cost_delete_table[c];
+        for (int c : codB) total += cost_insert_table[c];
+        return total;
+    }
+
+    int filasBloques = (m + tamBloque - 1) / tamBloque;
+    int columnasBloques = (n + tamBloque - 1) / tamBloque;
+
+    // Borde horizontal: las dos últimas filas calculadas en cada columna j (índice j + 1, la
+    // columna -1 nunca se usa). Lo escribe el bloque de arriba y lo lee el de abajo.
+    std::vector<int> bordeFilaPenultima(n + 2, INT_MAX), bordeFilaUltima(n + 2, INT_MAX);
+    bordeFilaUltima[1] = 0;
+    for (int j = 1; j <= n; ++j) {
+        bordeFilaUltima[j + 1] = bordeFilaUltima[j] + cost_insert_table[codB[j - 1]];
+    }
+
+    // Borde vertical de cada fila de bloques: las dos últimas columnas calculadas para las filas
+    // i0 - 2 .. i1 (incluye la esquina que necesita el bloque de la derecha).
+    int altoBorde = tamBloque + 2;
+    std::vector<int> bordeColPenultima(filasBloques * altoBorde, INT_MAX);
+    std::vector<int> bordeColUltima(filasBloques * altoBorde, INT_MAX);
+    std::vector<int> prefijoDel(m + 1, 0);
+    for (int i = 1; i <= m; ++i) {
+        prefijoDel[i] = prefijoDel[i - 1] + cost_delete_table[codA[i - 1]];
+    }
+    for (int bi = 0; bi < filasBloques; ++bi) {
+        int i0 = bi * tamBloque + 1;
+        int i1 = std::min(m, i0 + tamBloque - 1);
+        for (int i = std::max(0, i0 - 2); i <= i1; ++i) {
+            bordeColUltima[bi * altoBorde + (i - i0 + 2)] = prefijoDel[i];
+        }
+    }
+
+    // Dependencias pendientes de cada bloque (arriba e izquierda)
+    int totalBloques = filasBloques * columnasBloques;
+    std::vector<std::atomic<int>> pendientes(totalBloques);
+    for (int b = 0; b < totalBloques; ++b) {
+        int bi = b / columnasBloques;
+        int bj = b % columnasBloques;
+        pendientes[b].store((bi > 0) + (bj > 0));
+    }
+    std::atomic<int> restantes(totalBloques);
+    std::vector<ColaBloques> colas(hilos);
+    colas[0].bloques.push_back(0);
+
+    // Calcular un bloque con el núcleo de costos pre-codificados
+    auto calcularBloque = [&](int bloque, std::vector<int>& local) {
+        int bi = bloque / columnasBloques;
+        int bj = bloque % columnasBloques;
+        int i0 = bi * tamBloque + 1, i1 = std::min(m, i0 + tamBloque - 1);
+        int j0 = bj * tamBloque + 1, j1 = std::min(n, j0 + tamBloque - 1);
+        int ancho = j1 - j0 + 3; // columnas j0 - 2 .. j1
+        auto celda = [&](int i, int j) -> int& { return local[(i - i0 + 2) * ancho + (j - j0 + 2)]; };
+        int* colPenultima = &bordeColPenultima[bi * altoBorde];
+        int* colUltima = &bordeColUltima[bi * altoBorde];
+
+        // Cargar los bordes: dos filas de arriba y dos columnas de la izquierda (con la esquina)
+        for (int j = j0; j <= j1; ++j) {
+            celda(i0 - 2, j) = bordeFilaPenultima[j + 1];
+            celda(i0 - 1, j) = bordeFilaUltima[j + 1];
+        }
+        for (int i = i0 - 2; i <= i1; ++i) {
+            celda(i, j0 - 2) = colPenultima[i - i0 + 2];
+            celda(i, j0 - 1) = colUltima[i - i0 + 2];
+        }
+
+        for (int i = i0; i <= i1; ++i) {
+            const int* filaSub = cost_matrix[codA[i - 1]].data();
+            const int borrar = cost_delete_table[codA[i - 1]];
+            const char a = A[i - 1];
+            const char aPrevia = i > 1 ? A[i - 2] : '\0';
+            const int trans = i > 1 ? cost_transpose_matrix[codA[i - 1]][codA[i - 2]] : 0;
+            for (int j = j0; j <= j1; ++j) {
+                int valor = std::min(celda(i, j - 1) + cost_insert_table[codB[j - 1]], celda(i - 1, j) + borrar);
+                valor = std::min(valor, celda(i - 1, j - 1) + filaSub[codB[j - 1]]);
+                if (j > 1 && a == B[j - 2] && aPrevia == B[j - 1]) {
+                    valor = std::min(valor, celda(i - 2, j - 2) + trans);
+                }
+                celda(i, j) = valor;
+            }
+        }
+
+        // Publicar los bordes para el bloque de abajo y el de la derecha
+        for (int j = j0; j <= j1; ++j) {
+            bordeFilaPenultima[j + 1] = celda(i1 - 1, j);
+            bordeFilaUltima[j + 1] = celda(i1, j);
+        }
+        for (int i = i0 - 2; i <= i1; ++i) {
+            colPenultima[i - i0 + 2] = celda(i, j1 - 1);
+            colUltima[i - i0 + 2] = celda(i, j1);
+        }
+    };
+
+    auto trabajador = [&](int yo) {
+        std::vector<int> local((tamBloque + 2) * (tamBloque + 2));
+        while (restantes.load() > 0) {
+            int bloque = -1;
+            {
+                std::lock_guard<std::mutex> guardia(colas[yo].candado);
+                if (!colas[yo].bloques.empty()) {
+                    bloque = colas[yo].bloques.back();
+                    colas[yo].bloques.pop_back();
+                }
+            }
+            for (int otro = 1; bloque < 0 && otro < hilos; ++otro) {
+                ColaBloques& victima = colas[(yo + otro) % hilos];
+                std::lock_guard<std::mutex> guardia(victima.candado);
+                if (!victima.bloques.empty()) {
+                    bloque = victima.bloques.front();
+                    victima.bloques.pop_front();
+                }
+            }
+            if (bloque < 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            calcularBloque(bloque, local);
+
+            // Liberar el bloque de abajo y el de la derecha si ya no esperan a nadie más
+            int bi = bloque / columnasBloques;
+            int bj = bloque % columnasBloques;
+            int vecinos[2] = {bi + 1 < filasBloques ? bloque + columnasBloques : -1,
+                              bj + 1 < columnasBloques ? bloque + 1 : -1};
+            for (int vecino : vecinos) {
+                if (vecino >= 0 && pendientes[vecino].fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> guardia(colas[yo].candado);
+                    colas[yo].bloques.push_back(vecino);
+                }
+            }
+            restantes.fetch_sub(1);
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (int t = 1; t < hilos; ++t) {
+        trabajadores.emplace_back(trabajador, t);
+    }
+    trabajador(0);
+    for (std::thread& t : trabajadores) {
+        t.join();
+    }
+
+    return bordeFilaUltima[n + 1];
+}
+
+// Valor que devuelve minEditDistanceBounded cuando la distancia es mayor que k
+const int MAYOR_QUE_K = INT_MAX;
+
+// Distancia mínima de edición acotada: devuelve la distancia exacta si es <= k, o MAYOR_QUE_K.
+// Si una celda está en la diagonal t = j - i, todo camino que pase por ella necesita al menos
+// |t| inserciones/eliminaciones para llegar, y |(n - m) - t| para terminar. Con los costos mínimos
+// de inserción y eliminación eso da una cota inferior que solo depende de t, así que basta llenar
+// la banda de diagonales cuya cota es <= k: O(k·n) celdas en vez de O(m·n). Además se corta apenas
+// ninguna celda de las dos últimas filas puede terminar con costo <= k (la transposición salta
+// una fila, por eso se miran dos). Los códigos y la banda salen de 'memoria'.
+int minEditDistanceBounded(const std::string& A, const std::string& B, int k, MemoriaRapida& memoria) {
+    int m = A.size();
+    int n = B.size();
+    if (costos_negativos) {
+        // Con costos negativos las cotas no son válidas: se calcula todo
+        int distancia = minEditDistanceRapida(A, B, memoria);
+        return k >= 0 && distancia <= k ? distancia : MAYOR_QUE_K;
+    }
+
+    int minIns = *std::min_element(cost_insert_table.begin(), cost_insert_table.end());
+    int minDel = *std::min_element(cost_delete_table.begin(), cost_delete_table.end());
+
+    // Costo mínimo de desplazarse 'desvio' diagonales (positivo: inserciones, negativo: eliminaciones)
+    auto costoDesvio = [&](long long desvio) -> long long {
+        return desvio >= 0 ? desvio * minIns : -desvio * minDel;
+    };
+
+    // Banda de diagonales t = j - i con cota <= k (la cota es convexa en t)
+    int tlo = -m, thi = n;
+    while (tlo <= thi && costoDesvio(tlo) + costoDesvio((n - m) - tlo) > k) ++tlo;
+    while (thi >= tlo && costoDesvio(thi) + costoDesvio((n - m) - thi) > k) --thi;
+    int ancho = std::max(0, thi - tlo + 1);
+
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(3 * (ancho + 2)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* buffer = memoria.tomar<int>(3 * (ancho + 2));
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    if (k < 0 || tlo > thi) {
+        return MAYOR_QUE_K;
+    }
+
+    // Filas guardadas por diagonal: la celda (i, j) está en la posición j - i - tlo + 1. Las
+    // posiciones 0 y ancho + 1 quedan en INF para que los vecinos fuera de la banda no cuenten.
+    const int INF = INT_MAX / 2;
+    std::fill(buffer, buffer + 3 * (ancho + 2), INF);
+    int* previa2 = buffer;
+    int* previa = buffer + (ancho + 2);
+    int* actual = buffer + 2 * (ancho + 2);
+
+    // Fila 0: solo inserciones
+    int acumulado = 0;
+    for (int j = 0; j <= std::min(n, thi); ++j) {
+        if (j > 0) acumulado += cost_insert_table[codB[j - 1]];
+        if (j >= tlo) previa[j - tlo + 1] = std::min(acumulado, INF);
+    }
+    int minimoPrevia = INF;
+    for (int j = std::max(0, tlo); j <= std::min(n, thi); ++j) {
+        minimoPrevia = std::min<long long>(minimoPrevia, previa[j - tlo + 1] + costoDesvio((n - m) - j));
+    }
+
+    int bordeDel = 0; // dp[i][0]
+    for (int i = 1; i <= m; ++i) {
+        bordeDel = std::min(bordeDel + cost_delete_table[codA[i - 1]], INF);
+        std::fill(actual, actual + ancho + 2, INF);
+        const int* filaSub = cost_matrix[codA[i - 1]].data();
+        const int borrar = cost_delete_table[codA[i - 1]];
+        const int trans = i > 1 ? cost_transpose_matrix[codA[i - 1]][codA[i - 2]] : 0;
+        int jDesde = std::max(0, i + tlo);
+        int jHasta = std::min(n, i + thi);
+        METRICA_SUMAR(celdas, std::max(0, jHasta - jDesde + 1));
+        int minimoActual = INF;
+        for (int j = jDesde; j <= jHasta; ++j) {
+            int pos = j - i - tlo + 1;
+            int valor;
+            if (j == 0) {
+                valor = bordeDel;
+            } else {
+                valor = std::min(actual[pos - 1] + cost_insert_table[codB[j - 1]], previa[pos + 1] + borrar);
+                valor = std::min(valor, previa[pos] + filaSub[codB[j - 1]]);
+                if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
+                    valor = std::min(valor, previa2[pos] + trans);
+                }
+                valor = std::min(valor, INF);
+            }
+            actual[pos] = valor;
+            long long cota = valor + costoDesvio((n - j) - (m - i));
+            if (cota < minimoActual) minimoActual = static_cast<int>(cota);
+        }
+
+        // Todo camino cruza la fila i o la salta desde la fila i - 1 con una transposición
+        if (minimoActual > k && minimoPrevia > k) {
+            return MAYOR_QUE_K;
+        }
+        minimoPrevia = minimoActual;
+
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+
+    int distancia = previa[n - m - tlo + 1];
+    return distancia <= k ? distancia : MAYOR_QUE_K;
+}
+
+int minEditDistanceBounded(const std::string& A, const std::string& B, int k) {
+    MemoriaRapida memoria;
+    return minEditDistanceBounded(A, B, k, memoria);
+}
+
+// Alfabetos arbitrarios: una tabla de 256 entradas lleva cada byte a un código denso 0..k-1
+// (-1 si el byte no es del alfabeto), y las tablas de costos tienen el tamaño de ese alfabeto
+// (k inserciones y eliminaciones, k*k sustituciones y transposiciones). Con alfabetos chicos,
+// como ACGT, las tablas completas caben en unas pocas líneas de caché.
+class Alfabeto {
+public:
+    // "bytes" es el alfabeto de los 256 bytes; cualquier otra cadena declara los símbolos en orden
+    explicit Alfabeto(const std::string& simbolos) {
+        codigo.fill(-1);
+        if (simbolos == "bytes") {
+            for (int u = 0; u < 256; ++u) {
+                codigo[u] = u;
+            }
+            cantidad = 256;
+            return;
+        }
+        for (char c : simbolos) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (codigo[u] >= 0) {
+                throw std::invalid_argument("Símbolo repetido en el alfabeto: '" + std::string(1, c) + "'");
+            }
+            codigo[u] = cantidad++;
+        }
+        if (cantidad == 0) {
+            throw std::invalid_argument("El alfabeto no puede estar vacío");
+        }
+    }
+
+    int tamano() const {
+        return cantidad;
+    }
+
+    // Codificar una cadena validando cada carácter una sola vez
+    std::vector<uint8_t> codificar(const std::string& cadena) const {
+        std::vector<uint8_t> codigos(cadena.size());
+        for (size_t k = 0; k < cadena.size(); ++k) {
+            int c = codigo[static_cast<unsigned char>(cadena[k])];
+            if (c < 0) {
+                throw std::invalid_argument("El carácter '" + std::string(1, cadena[k]) + "' no pertenece al alfabeto.");
+            }
+            codigos[k] = static_cast<uint8_t>(c);
+        }
+        return codigos;
+    }
+
+private:
+    std::array<int16_t, 256> codigo;
+    int cantidad = 0;
+};
+
+// Tablas de costos del tamaño de un alfabeto (filas de sustitución y transposición contiguas)
+struct CostosAlfabeto {
+    int tamano = 0;
+    std::vector<int32_t> insertar;
+    std::vector<int32_t> eliminar;
+    std::vector<int32_t> sustituir;
+    std::vector<int32_t> transponer;
+
+    // Leer los cuatro archivos de una carpeta (mismos nombres que las tablas de letras)
+    static CostosAlfabeto cargar(const std::string& carpeta, const Alfabeto& alfabeto) {
+        CostosAlfabeto costos;
+        int k = alfabeto.tamano();
+        costos.tamano = k;
+        costos.insertar = leerValoresEstricto(carpeta + "/cost_insert.txt", k);
+        costos.eliminar = leerValoresEstricto(carpeta + "/cost_delete.txt", k);
+        costos.sustituir = leerValoresEstricto(carpeta + "/cost_replace.txt", k * k);
+        costos.transponer = leerValoresEstricto(carpeta + "/cost_transpose.txt", k * k);
+        return costos;
+    }
+
+    // Costos unitarios: 1 por operación y 0 por sustituir un símbolo por sí mismo
+    static CostosAlfabeto unitarios(const Alfabeto& alfabeto) {
+        CostosAlfabeto costos;
+        int k = alfabeto.tamano();
+        costos.tamano = k;
+        costos.insertar.assign(k, 1);
+        costos.eliminar.assign(k, 1);
+        costos.sustituir.assign(k * k, 1);
+        costos.transponer.assign(k * k, 1);
+        for (int c = 0; c < k; ++c) {
+            costos.sustituir[c * k + c] = 0;
+        }
+        return costos;
+    }
+};
+
+// Secuencia de ADN empaquetada con 2 bits por base (A=0, C=1, G=2, T=3), 32 bases por palabra:
+// ocupa la cuarta parte que la misma secuencia en un std::string.
+class SecuenciaADN {
+public:
+    void agregar(int base) {
+        if (largo % 32 == 0) {
+            palabras.push_back(0);
+        }
+        palabras.back() |= static_cast<uint64_t>(base) << (2 * (largo % 32));
+        ++largo;
+    }
+
+    size_t size() const {
+        return largo;
+    }
+
+    int operator[](size_t k) const {
+        return (palabras[k / 32] >> (2 * (k % 32))) & 3;
+    }
+
+    size_t bytes() const {
+        return palabras.capacity() * sizeof(uint64_t);
+    }
+
+    void reservar(size_t bases) {
+        palabras.reserve((bases + 31) / 32);
+    }
+
+private:
+    std::vector<uint64_t> palabras;
+    size_t largo = 0;
+};
+
+// Leer la primera secuencia de un archivo FASTA (o un archivo con solo la secuencia). Se ignoran
+// las líneas de encabezado ('>' o ';') y los espacios; las bases se aceptan en mayúscula o
+// minúscula y cualquier otro carácter es un error.
+SecuenciaADN leerSecuenciaADN(const std::string& ruta) {
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo.is_open()) {
+        throw std::runtime_error("Error al abrir el archivo: " + ruta);
+    }
+    archivo.seekg(0, std::ios::end);
+    std::streamoff tamano = archivo.tellg();
+    archivo.seekg(0, std::ios::beg);
+
+    SecuenciaADN secuencia;
+    secuencia.reservar(tamano > 0 ? static_cast<size_t>(tamano) : 0);
+    std::string linea;
+    bool enRegistro = false;
+    while (std::getline(archivo, linea)) {
+        if (!linea.empty() && (linea[0] == '>' || linea[0] == ';')) {
+            if (linea[0] == '>' && enRegistro) {
+                break; // solo la primera secuencia
+            }
+            enRegistro = enRegistro || linea[0] == '>';
+            continue;
+        }
+        enRegistro = true;
+        for (char c : linea) {
+            switch (c) {
+                case 'A': case 'a': secuencia.agregar(0); break;
+                case 'C': case 'c': secuencia.agregar(1); break;
+                case 'G': case 'g': secuencia.agregar(2); break;
+                case 'T': case 't': secuencia.agregar(3); break;
+                case ' ': case '\t': case '\r': break;
+                default:
+                    throw std::invalid_argument("El carácter '" + std::string(1, c) + "' no es una base (ACGT) en " + ruta);
+            }
+        }
+    }
+    return secuencia;
+}
+
+// Distancia mínima de edición sobre códigos de un alfabeto cualquiera. A y B solo necesitan
+// size() y operator[] con el código de cada posición (std::vector<uint8_t> o SecuenciaADN).
+// Es la misma recurrencia de minEditDistanceRapida, con tres filas y las tablas del alfabeto;
+// la transposición compara códigos.
+template <typename SecuenciaA, typename SecuenciaB>
+int minEditDistanceAlfabeto(const SecuenciaA& A, const SecuenciaB& B, const CostosAlfabeto& costos) {
+    int m = A.size();
+    int n = B.size();
+    const int k = costos.tamano;
+    const int32_t* insertar = costos.insertar.data();
+    // B se decodifica una vez a un byte por posición (ocupa menos que una de las filas), para
+    // que el ciclo interno no desempaque bits en cada celda
+    std::vector<uint8_t> codB(n);
+    for (int j = 0; j < n; ++j) {
+        codB[j] = B[j];
+    }
+
+    std::vector<int> filas(3 * (n + 1));
+    int* previa2 = filas.data();
+    int* previa = filas.data() + (n + 1);
+    int* actual = filas.data() + 2 * (n + 1);
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = previa[j - 1] + insertar[codB[j - 1]];
+    }
+
+    int aPrevia = -1; // con i == 1 no hay transposición
+    for (int i = 1; i <= m; ++i) {
+        const int a = A[i - 1];
+        const int32_t* filaSub = costos.sustituir.data() + a * k;
+        const int borrar = costos.eliminar[a];
+        const int trans = aPrevia >= 0 ? costos.transponer[a * k + aPrevia] : 0;
+
+        actual[0] = previa[0] + borrar;
+        int bPrevia = -1;
+        for (int j = 1; j <= n; ++j) {
+            const int b = codB[j - 1];
+            int valor = std::min(actual[j - 1] + insertar[b], previa[j] + borrar);
+            valor = std::min(valor, previa[j - 1] + filaSub[b]);
+            if (a == bPrevia && aPrevia == b) {
+                valor = std::min(valor, previa2[j - 2] + trans);
+            }
+            actual[j] = valor;
+            bPrevia = b;
+        }
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+        aPrevia = a;
+    }
+    return previa[n];
+}
+
+// Sesión incremental: A es fija y B llega de a una letra (por ejemplo, mientras se escribe).
+// Se guardan columnas del DP (una por prefijo de B, con largo |A| + 1) en un anillo de
+// 'capacidad' columnas (al menos 3): agregar una letra calcula una columna nueva desde las dos
+// anteriores (dos por la transposición) en O(|A|), y quitar la última letra solo retrocede en el anillo.
+// Si se quitan más letras de las que guarda el anillo, se recalculan las columnas desde cero.
+class SesionIncremental {
+public:
+    explicit SesionIncremental(const std::string& a, int capacidadColumnas = 64)
+        : A(a), codA(codificarCadena(a)), m(a.size()), capacidad(std::max(3, capacidadColumnas)) {
+        anillo.resize(static_cast<size_t>(capacidad) * (m + 1));
+        recalcular();
+    }
+
+    // Agregar una letra al final de B (se valida como en codificarCadena)
+    void agregar(char letra) {
+        unsigned char u = static_cast<unsigned char>(letra);
+        if (!std::isalpha(u)) {
+            throw std::invalid_argument("El carácter '" + std::string(1, letra) + "' no es una letra válida.");
+        }
+        B.push_back(letra);
+        codB.push_back(std::tolower(u) - 'a');
+        int n = B.size();
+        calcularColumna(n);
+        if (n - primeraGuardada >= capacidad) {
+            primeraGuardada = n - capacidad + 1;
+        }
+    }
+
+    // Quitar la última letra de B (no hace nada si B está vacía)
+    void quitar() {
+        if (B.empty()) {
+            return;
+        }
+        B.pop_back();
+        codB.pop_back();
+        int n = B.size();
+        // La próxima columna necesita las columnas n y n - 1
+        if (n < primeraGuardada || (n >= 1 && n - 1 < primeraGuardada)) {
+            ++recalculos;
+            recalcular();
+        }
+    }
+
+    // Distancia actual entre A y B
+    int distancia() const {
+        return anillo[static_cast<size_t>(B.size() % capacidad) * (m + 1) + m];
+    }
+
+    const std::string& cadenaB() const {
+        return B;
+    }
+
+    long long recalculos = 0;
+
+private:
+    int* columna(int j) {
+        return anillo.data() + static_cast<size_t>(j % capacidad) * (m + 1);
+    }
+
+    // Columna j (1..|B|) a partir de las columnas j - 1 y j - 2 del anillo
+    void calcularColumna(int j) {
+        const int* previa = columna(j - 1);
+        const int* previa2 = j > 1 ? columna(j - 2) : nullptr;
+        int* actual = columna(j);
+        const int b = codB[j - 1];
+        const int insertar = cost_insert_table[b];
+        actual[0] = previa[0] + insertar;
+        for (int i = 1; i <= m; ++i) {
+            int valor = std::min({actual[i - 1] + cost_delete_table[codA[i - 1]], previa[i] + insertar,
+                                  previa[i - 1] + cost_matrix[codA[i - 1]][b]});
+            if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
+                valor = std::min(valor, previa2[i - 2] + cost_transpose_matrix[codA[i - 1]][codA[i - 2]]);
+            }
+            actual[i] = valor;
+        }
+    }
+
+    // Calcular desde cero todas las columnas de B (el anillo se queda con las últimas)
+    void recalcular() {
+        int* columna0 = columna(0);
+        columna0[0] = 0;
+        for (int i = 1; i <= m; ++i) {
+            columna0[i] = columna0[i - 1] + cost_delete_table[codA[i - 1]];
+        }
+        int n = B.size();
+        for (int j = 1; j <= n; ++j) {
+            calcularColumna(j);
+        }
+        primeraGuardada = std::max(0, n - capacidad + 1);
+    }
+
+    std::string A;
+    std::vector<int> codA;
+    std::string B;
+    std::vector<int> codB;
+    int m;
+    int capacidad;
+    int primeraGuardada = 0;
+    std::vector<int> anillo;
+};
+
+// Búsqueda aproximada de un patrón dentro de un texto (semi-global, al estilo de Sellers).
+// Es la misma recurrencia con el patrón como filas y el texto como columnas, pero la fila 0 vale
+// 0 en todas las columnas: una coincidencia puede empezar en cualquier posición del texto. Se
+// guardan solo las dos últimas columnas (por la transposición) y la columna actual, así que el
+// texto puede llegar por partes. Cada posición donde la última fila queda <= k es el final de una
+// coincidencia. Los caracteres que no son letras no tienen costo en las tablas: cortan las
+// coincidencias (las columnas vuelven al estado inicial).
+class BusquedaAproximada {
+public:
+    BusquedaAproximada(const std::string& patron, int k) : A(patron), m(patron.size()), limite(k) {
+        std::vector<int> codA = codificarCadena(patron);
+        borrar.resize(m + 1, 0);
+        transponer.resize(m + 1, 0);
+        for (int i = 1; i <= m; ++i) {
+            borrar[i] = cost_delete_table[codA[i - 1]];
+            if (i > 1) {
+                transponer[i] = cost_transpose_matrix[codA[i - 1]][codA[i - 2]];
+            }
+        }
+        // Costos de sustitución por letra del texto, contiguos a lo largo del patrón
+        sustituir.resize(static_cast<size_t>(ALPHABET_SIZE) * (m + 1), 0);
+        for (int c = 0; c < ALPHABET_SIZE; ++c) {
+            for (int i = 1; i <= m; ++i) {
+                sustituir[static_cast<size_t>(c) * (m + 1) + i] = cost_matrix[codA[i - 1]][c];
+            }
+        }
+        // Código de cada byte del texto (-1 si no es letra), para no llamar isalpha por byte
+        for (int u = 0; u < 256; ++u) {
+            codigoByte[u] = std::isalpha(u) ? std::tolower(u) - 'a' : -1;
+        }
+        columnas.resize(3 * static_cast<size_t>(m + 1));
+        reiniciar();
+    }
+
+    // Procesar un bloque del texto que empieza en 'desplazamiento' bytes desde el inicio.
+    // Por cada coincidencia llama informar(posición del último carácter, costo).
+    template <typename Informar>
+    void procesar(const char* texto, size_t largo, uint64_t desplazamiento, Informar informar) {
+        for (size_t p = 0; p < largo; ++p) {
+            const char b = texto[p];
+            const int c = codigoByte[static_cast<unsigned char>(b)];
+            if (c < 0) {
+                reiniciar();
+                continue;
+            }
+            const int* filaSub = sustituir.data() + static_cast<size_t>(c) * (m + 1);
+            const int insertar = cost_insert_table[c];
+
+            actual[0] = 0;
+            for (int i = 1; i <= m; ++i) {
+                int valor = std::min(actual[i - 1] + borrar[i], previa[i] + insertar);
+                valor = std::min(valor, previa[i - 1] + filaSub[i]);
+                // En la primera letra de un tramo 'anterior' es '\0' y nunca coincide
+                if (i > 1 && A[i - 1] == anterior && A[i - 2] == b) {
+                    valor = std::min(valor, previa2[i - 2] + transponer[i]);
+                }
+                actual[i] = valor;
+            }
+            if (actual[m] <= limite) {
+                informar(desplazamiento + p, actual[m]);
+            }
+
+            int* libre = previa2;
+            previa2 = previa;
+            previa = actual;
+            actual = libre;
+            anterior = b;
+        }
+    }
+
+private:
+    // Estado antes de la primera letra de un tramo: solo eliminaciones del patrón
+    void reiniciar() {
+        previa2 = columnas.data();
+        previa = columnas.data() + (m + 1);
+        actual = columnas.data() + 2 * (m + 1);
+        previa[0] = 0;
+        for (int i = 1; i <= m; ++i) {
+            previa[i] = previa[i - 1] + borrar[i];
+        }
+        anterior = '\0';
+    }
+
+    std::string A;
+    int m;
+    int limite;
+    std::vector<int> borrar;
+    std::vector<int> transponer;
+    std::vector<int> sustituir;
+    std::vector<int> columnas;
+    std::array<int, 256> codigoByte{};
+    int* previa2 = nullptr;
+    int* previa = nullptr;
+    int* actual = nullptr;
+    char anterior = '\0';
+};
+
+// Recorrer un archivo mapeándolo en memoria por bloques de 'tamBloque' bytes (sin copiarlo)
+// y pasar cada bloque a la búsqueda. Devuelve la cantidad de bytes leídos.
+template <typename Informar>
+uint64_t buscarEnArchivo(const std::string& ruta, BusquedaAproximada& busqueda, size_t tamBloque, Informar informar) {
+    int descriptor = open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Error al abrir el archivo: " + ruta);
+    }
+    struct stat info;
+    if (fstat(descriptor, &info) != 0) {
+        close(descriptor);
+        throw std::runtime_error("No se pudo leer el tamaño de: " + ruta);
+    }
+    uint64_t tamano = info.st_size;
+    // Los bloques empiezan en múltiplos del tamaño de página, como pide mmap
+    size_t pagina = sysconf(_SC_PAGESIZE);
+    tamBloque = std::max(pagina, tamBloque / pagina * pagina);
+
+    for (uint64_t inicio = 0; inicio < tamano; inicio += tamBloque) {
+        size_t largo = std::min<uint64_t>(tamBloque, tamano - inicio);
+        void* mapa = mmap(nullptr, largo, PROT_READ, MAP_PRIVATE, descriptor, inicio);
+        if (mapa == MAP_FAILED) {
+            close(descriptor);
+            throw std::runtime_error("No se pudo mapear el archivo: " + ruta);
+        }
+        madvise(mapa, largo, MADV_SEQUENTIAL);
+        busqueda.procesar(static_cast<const char*>(mapa), largo, inicio, informar);
+        munmap(mapa, largo);
+    }
+    close(descriptor);
+    return tamano;
+}
+
+// Filtro de cotas inferiores para descartar candidatos sin calcular el DP.
+// Para una consulta A y un candidato B se calculan cotas que nunca sobreestiman la distancia
+// (con costos no negativos); si alguna supera k el candidato se descarta:
+//  - largo: |n - m| inserciones o eliminaciones al costo mínimo,
+//  - histograma: si A tiene d letras x de más, cada una se elimina o se sustituye por otra, y
+//    cada operación arregla una sola letra de más (lo mismo para las letras que faltan, con
+//    inserción o sustitución hacia esa letra). La transposición no cambia el histograma.
+// Los candidatos que pasan van a minEditDistanceBounded. Si hay costos negativos no se filtra.
+class FiltroCandidatos {
+public:
+    FiltroCandidatos() {
+        minIns = *std::min_element(cost_insert_table.begin(), cost_insert_table.end());
+        minDel = *std::min_element(cost_delete_table.begin(), cost_delete_table.end());
+        for (int x = 0; x < ALPHABET_SIZE; ++x) {
+            int salir = INT_MAX, entrar = INT_MAX;
+            for (int y = 0; y < ALPHABET_SIZE; ++y) {
+                if (y != x) {
+                    salir = std::min(salir, cost_matrix[x][y]);
+                    entrar = std::min(entrar, cost_matrix[y][x]);
+                }
+            }
+            costoSobra[x] = std::min(cost_delete_table[x], salir);
+            costoFalta[x] = std::min(cost_insert_table[x], entrar);
+        }
+    }
+
+    // Fijar la consulta (se calcula su histograma una vez)
+    void fijarConsulta(const std::string& consulta) {
+        A = consulta;
+        histogramaA.fill(0);
+        for (int c : codificarCadena(consulta)) {
+            ++histogramaA[c];
+        }
+    }
+
+    // Cota inferior de la distancia entre la consulta y 'candidato'. 'porLargo' queda en true si
+    // la cota por diferencia de largo ya supera k (y entonces no se mira el histograma).
+    long long cotaInferior(const std::string& candidato, int k, bool& porLargo) const {
+        long long diferencia = static_cast<long long>(candidato.size()) - static_cast<long long>(A.size());
+        long long cotaLargo = diferencia >= 0 ? diferencia * minIns : -diferencia * minDel;
+        porLargo = true;
+        if (cotaLargo > k) {
+            return cotaLargo;
+        }
+        porLargo = false;
+
+        std::array<int, ALPHABET_SIZE> diferencias = histogramaA;
+        for (char c : candidato) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (!std::isalpha(u)) {
+                return 0; // lo rechazará el DP con su propio error
+            }
+            --diferencias[std::tolower(u) - 'a'];
+        }
+        long long sobra = 0, falta = 0;
+        for (int x = 0; x < ALPHABET_SIZE; ++x) {
+            if (diferencias[x] > 0) {
+                sobra += static_cast<long long>(diferencias[x]) * costoSobra[x];
+            } else {
+                falta += static_cast<long long>(-diferencias[x]) * costoFalta[x];
+            }
+        }
+        return std::max({cotaLargo, sobra, falta});
+    }
+
+    // Distancia exacta si es <= k, o MAYOR_QUE_K (descartando primero por cotas)
+    int distanciaAcotada(const std::string& candidato, int k) {
+        ++candidatos;
+        bool porLargo = false;
+        // Con costos negativos las cotas pueden sobreestimar: todo va directo al DP acotado
+        if (!costos_negativos && cotaInferior(candidato, k, porLargo) > k) {
+            ++(porLargo ? descartadosPorLargo : descartadosPorHistograma);
+            return MAYOR_QUE_K;
+        }
+        return minEditDistanceBounded(A, candidato, k);
+    }
+
+    long long candidatos = 0;
+    long long descartadosPorLargo = 0;
+    long long descartadosPorHistograma = 0;
+
+private:
+    std::string A;
+    std::array<int, ALPHABET_SIZE> histogramaA{};
+    std::array<int, ALPHABET_SIZE> costoSobra{};
+    std::array<int, ALPHABET_SIZE> costoFalta{};
+    int minIns = 0;
+    int minDel = 0;
+};
+
+// Diccionario en un trie para buscar las palabras más cercanas a una consulta.
+// Se calcula minEditDistance(consulta, palabra) para todas las palabras a la vez: cada arista del
+// trie agrega una letra de la palabra, es decir, una columna del DP (de largo |consulta| + 1). Las
+// palabras con un prefijo común comparten esas columnas. Un subárbol se descarta cuando ninguna
+// celda de las dos últimas columnas es <= al umbral (la transposición salta una columna), donde el
+// umbral es el límite pedido o la k-ésima mejor distancia encontrada hasta ahora. Con costos
+// negativos no se descarta ningún subárbol.
+class DiccionarioTrie {
+public:
+    DiccionarioTrie() {
+        nodos.push_back(Nodo()); // raíz
+    }
+
+    // Agregar una palabra (se valida que tenga solo letras). Devuelve false si ya estaba.
+    bool agregar(const std::string& palabra) {
+        codificarCadena(palabra);
+        int actual = 0;
+        for (char c : palabra) {
+            int hijo = nodos[actual].primerHijo;
+            while (hijo >= 0 && nodos[hijo].letra != c) {
+                hijo = nodos[hijo].siguienteHermano;
+            }
+            if (hijo < 0) {
+                hijo = nodos.size();
+                Nodo nuevo;
+                nuevo.letra = c;
+                nuevo.siguienteHermano = nodos[actual].primerHijo;
+                nodos.push_back(nuevo);
+                nodos[actual].primerHijo = hijo;
+            }
+            actual = hijo;
+        }
+        if (nodos[actual].palabra >= 0) {
+            return false;
+        }
+        nodos[actual].palabra = palabras.size();
+        palabras.push_back(palabra);
+        return true;
+    }
+
+    size_t cantidadPalabras() const {
+        return palabras.size();
+    }
+
+    // Las k palabras más cercanas con distancia <= limite, ordenadas por distancia
+    std::vector<std::pair<int, std::string>> buscar(const std::string& consulta, int k, int limite = INT_MAX) const {
+        Busqueda b;
+        b.consulta = &consulta;
+        b.codConsulta = codificarCadena(consulta);
+        if (k <= 0) {
+            return {}; // registrar supone que el montón puede tener al menos una palabra
+        }
+        b.k = k;
+        b.limite = limite;
+        int m = consulta.size();
+
+        // Columna 0: eliminar toda la consulta
+        std::vector<int> columna0(m + 1, 0);
+        for (int i = 1; i <= m; ++i) {
+            columna0[i] = columna0[i - 1] + cost_delete_table[b.codConsulta[i - 1]];
+        }
+        b.columnas.push_back(columna0);
+        if (nodos[0].palabra >= 0) {
+            registrar(b, columna0[m], nodos[0].palabra);
+        }
+        for (int hijo = nodos[0].primerHijo; hijo >= 0; hijo = nodos[hijo].siguienteHermano) {
+            recorrer(b, hijo, 1);
+        }
+
+        std::vector<std::pair<int, std::string>> resultado;
+        while (!b.mejores.empty()) {
+            resultado.emplace_back(b.mejores.top().first, palabras[b.mejores.top().second]);
+            b.mejores.pop();
+        }
+        std::reverse(resultado.begin(), resultado.end());
+        return resultado;
+    }
+
+private:
+    struct Nodo {
+        char letra = '\0';
+        int primerHijo = -1;
+        int siguienteHermano = -1;
+        int palabra = -1; // índice en 'palabras' si aquí termina una palabra
+    };
+
+    // Estado de una búsqueda: columnas del camino actual y las k mejores (montículo de máximos)
+    struct Busqueda {
+        const std::string* consulta;
+        std::vector<int> codConsulta;
+        int k;
+        int limite;
+        std::vector<std::vector<int>> columnas; // columnas[j] = columna j del camino actual
+        std::string camino;                     // letras del camino actual (B[0..j))
+        std::priority_queue<std::pair<int, int>> mejores;
+    };
+
+    std::vector<Nodo> nodos;
+    std::vector<std::string> palabras;
+
+    static int umbral(const Busqueda& b) {
+        if (static_cast<int>(b.mejores.size()) < b.k) {
+            return b.limite;
+        }
+        return std::min(b.limite, b.mejores.top().first);
+    }
+
+    static void registrar(Busqueda& b, int distancia, int palabra) {
+        if (distancia > b.limite) {
+            return;
+        }
+        if (static_cast<int>(b.mejores.size()) < b.k) {
+            b.mejores.emplace(distancia, palabra);
+        } else if (distancia < b.mejores.top().first) {
+            b.mejores.pop();
+            b.mejores.emplace(distancia, palabra);
+        }
+    }
+
+    void recorrer(Busqueda& b, int nodo, int j) const {
+        const std::string& A = *b.consulta;
+        int m = A.size();
+        char c = nodos[nodo].letra;
+        int codC = std::tolower(static_cast<unsigned char>(c)) - 'a';
+        int insertar = cost_insert_table[codC];
+        char cPrevia = j > 1 ? b.camino[j - 2] : '\0';
+
+        if (static_cast<int>(b.columnas.size()) <= j) {
+            b.columnas.emplace_back(m + 1);
+        }
+        b.camino.resize(j - 1);
+        b.camino.push_back(c);
+        const std::vector<int>& previa = b.columnas[j - 1];
+        const std::vector<int>* previa2 = j > 1 ? &b.columnas[j - 2] : nullptr;
+        std::vector<int>& columna = b.columnas[j];
+
+        columna[0] = previa[0] + insertar;
+        int minimo = columna[0];
+        for (int i = 1; i <= m; ++i) {
+            int valor = std::min(previa[i] + insertar, columna[i - 1] + cost_delete_table[b.codConsulta[i - 1]]);
+            valor = std::min(valor, previa[i - 1] + cost_matrix[b.codConsulta[i - 1]][codC]);
+            if (i > 1 && j > 1 && A[i - 1] == cPrevia && A[i - 2] == c) {
+                valor = std::min(valor, (*previa2)[i - 2] + cost_transpose_matrix[b.codConsulta[i - 1]][b.codConsulta[i - 2]]);
+            }
+            columna[i] = valor;
+            minimo = std::min(minimo, valor);
+        }
+
+        if (nodos[nodo].palabra >= 0) {
+            registrar(b, columna[m], nodos[nodo].palabra);
+        }
+
+        int minimoPrevia = *std::min_element(previa.begin(), previa.end());
+        // Ningún descendiente puede mejorar; vale solo con costos no negativos (con negativos, una
+        // letra más adelante puede bajar la distancia y no se poda)
+        if (!costos_negativos && minimo > umbral(b) && minimoPrevia > umbral(b)) {
+            return;
+        }
+        for (int hijo = nodos[nodo].primerHijo; hijo >= 0; hijo = nodos[hijo].siguienteHermano) {
+            recorrer(b, hijo, j + 1);
+        }
+    }
+};
+
+// Guion de operaciones para el servidor y el modo por lotes: la misma reconstrucción del DP
+// reconstructor (tabla de punteros y empates en el orden inserción, eliminación, sustitución y
+// transposición), con un byte por celda en la memoria de la hebra. Pasado este tamaño el pedido
+// se rechaza.
+enum TipoOperacion : uint8_t { INSERTAR = 0, ELIMINAR = 1, SUSTITUIR = 2, TRANSPONER = 3 };
+
+struct EditOp {
+    TipoOperacion tipo;
+    int posA; // posición en A (al transponer, la primera de las dos letras)
+    int posB; // posición en B
+};
+
+const long long MAXIMO_CELDAS_GUION = 1LL << 26;
+
+int guionEdicionTabla(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones, MemoriaRapida& memoria) {
+    const int m = A.size();
+    const int n = B.size();
+    if (1LL * (m + 1) * (n + 1) > MAXIMO_CELDAS_GUION) {
+        throw std::length_error("Cadenas demasiado largas para reconstruir las operaciones");
+    }
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(3 * (n + 1)) +
+                     MemoriaRapida::bytesPara<uint8_t>(static_cast<size_t>(m + 1) * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* filas = memoria.tomar<int>(3 * (n + 1));
+    uint8_t* punteros = memoria.tomar<uint8_t>(static_cast<size_t>(m + 1) * (n + 1));
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    int* previa2 = filas;
+    int* previa = filas + (n + 1);
+    int* actual = filas + 2 * (n + 1);
+
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = previa[j - 1] + cost_insert_table[codB[j - 1]];
+        punteros[j] = INSERTAR;
+    }
+    for (int i = 1; i <= m; ++i) {
+        uint8_t* filaPunteros = punteros + static_cast<size_t>(i) * (n + 1);
+        const int* filaSub = cost_matrix[codA[i - 1]].data();
+        const int borrar = cost_delete_table[codA[i - 1]];
+        actual[0] = previa[0] + borrar;
+        filaPunteros[0] = ELIMINAR;
+        for (int j = 1; j <= n; ++j) {
+            int valor = actual[j - 1] + cost_insert_table[codB[j - 1]];
+            uint8_t tipo = INSERTAR;
+            if (previa[j] + borrar < valor) {
+                valor = previa[j] + borrar;
+                tipo = ELIMINAR;
+            }
+            if (previa[j - 1] + filaSub[codB[j - 1]] < valor) {
+                valor = previa[j - 1] + filaSub[codB[j - 1]];
+                tipo = SUSTITUIR;
+            }
+            if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
+                int costo = previa2[j - 2] + cost_transpose_matrix[codA[i - 1]][codA[i - 2]];
+                if (costo < valor) {
+                    valor = costo;
+                    tipo = TRANSPONER;
+                }
+            }
+            actual[j] = valor;
+            filaPunteros[j] = tipo;
+        }
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
+    }
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+
+    operaciones.clear();
+    int i = m, j = n;
+    while (i > 0 || j > 0) {
+        switch (punteros[static_cast<size_t>(i) * (n + 1) + j]) {
+            case INSERTAR:
+                operaciones.push_back({INSERTAR, i, j - 1});
+                --j;
+                break;
+            case ELIMINAR:
+                operaciones.push_back({ELIMINAR, i - 1, j});
+                --i;
+                break;
+            case SUSTITUIR:
+                if (A[i - 1] != B[j - 1]) {
+                    operaciones.push_back({SUSTITUIR, i - 1, j - 1});
+                }
+                --i;
+                --j;
+                break;
+            default:
+                operaciones.push_back({TRANSPONER, i - 2, j - 2});
+                i -= 2;
+                j -= 2;
+                break;
+        }
+    }
+    std::reverse(operaciones.begin(), operaciones.end());
+    return previa[n];
+}
+
+// Con la etapa de reducción delante: la tabla solo cubre la parte central y las posiciones de las
+// operaciones se corren de vuelta a los índices de A y B completas
+int guionEdicion(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones, MemoriaRapida& memoria) {
+    Recorte r = recortarComunes(A, B);
+    if (r.prefijo == 0 && r.sufijo == 0) {
+        return guionEdicionTabla(A, B, operaciones, memoria);
+    }
+    memoria.parteA.assign(A, r.prefijo, A.size() - r.prefijo - r.sufijo);
+    memoria.parteB.assign(B, r.prefijo, B.size() - r.prefijo - r.sufijo);
+    int distancia = guionEdicionTabla(memoria.parteA, memoria.parteB, operaciones, memoria);
+    for (EditOp& op : operaciones) {
+        op.posA += r.prefijo;
+        op.posB += r.prefijo;
+    }
+    return distancia;
+}
+
+// Agregar las operaciones a una línea de respuesta: " I<posA>:<posB> E<posA> S<posA>:<posB> T<posA> ..."
+void agregarGuion(std::string& texto, const std::vector<EditOp>& operaciones) {
+    static const char letras[] = {'I', 'E', 'S', 'T'};
+    for (const EditOp& op : operaciones) {
+        texto += ' ';
+        texto += letras[op.tipo];
+        texto += std::to_string(op.posA);
+        if (op.tipo == INSERTAR || op.tipo == SUSTITUIR) {
+            texto += ':';
+            texto += std::to_string(op.posB);
+        }
+    }
+}
+
+// Histograma de latencias de tamaño fijo: 8 casillas por potencia de 2 (cada una cubre ~9% del
+// valor) desde 1/16 de microsegundo hasta ~17 minutos, más una para lo que queda fuera. Así el
+// modo por lotes puede dar percentiles de millones de pares sin guardar una latencia por par.
+class HistogramaLatencias {
+public:
+    void agregar(double us) {
+        int casilla = us <= MINIMO_US ? 0 : static_cast<int>(std::log2(us / MINIMO_US) * POR_OCTAVA) + 1;
+        ++cuentas[std::min(casilla, CASILLAS - 1)];
+        ++total;
+        maximo = std::max(maximo, us);
+    }
+
+    void unir(const HistogramaLatencias& otro) {
+        for (int c = 0; c < CASILLAS; ++c) {
+            cuentas[c] += otro.cuentas[c];
+        }
+        total += otro.total;
+        maximo = std::max(maximo, otro.maximo);
+    }
+
+    // Borde superior de la casilla donde cae el percentil p (sin pasarse del máximo visto)
+    double percentil(double p) const {
+        if (total == 0) return 0.0;
+        uint64_t objetivo = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * total)));
+        uint64_t acumulado = 0;
+        for (int c = 0; c < CASILLAS; ++c) {
+            acumulado += cuentas[c];
+            if (acumulado >= objetivo) {
+                return std::min(maximo, MINIMO_US * std::exp2(static_cast<double>(c) / POR_OCTAVA));
+            }
+        }
+        return maximo;
+    }
+
+    double maximoUs() const {
+        return maximo;
+    }
+
+private:
+    static constexpr double MINIMO_US = 1.0 / 16;
+    static constexpr int POR_OCTAVA = 8;
+    static constexpr int CASILLAS = 34 * POR_OCTAVA + 2;
+    std::array<uint64_t, CASILLAS> cuentas{};
+    uint64_t total = 0;
+    double maximo = 0.0;
+};
+
+// Grupo de pares leídos juntos en el modo por lotes. 'indice' es el orden de lectura, que
+// también es el orden de escritura. Con el guion, 'guiones' tiene las operaciones de cada par.
+struct GrupoPares {
+    long indice = 0;
+    std::vector<std::pair<std::string, std::string>> pares;
+    std::vector<int> distancias;
+    std::vector<bool> validos;
+    std::vector<std::string> guiones;
+    HistogramaLatencias latencias;
+};
+
+// Modo por lotes: lee pares "A B" (uno por línea, separados por un espacio o tabulación) desde
+// 'entrada', calcula sus distancias con 'hilos' hebras y escribe una distancia por línea en
+// 'salida', en el mismo orden de la entrada. La entrada se procesa por grupos y nunca hay más de 4
+// grupos por hebra en memoria. Las tablas de costos (globales) se cargan una vez y las hebras solo
+// las leen. Los pares que no se pueden calcular (caracteres inválidos, cadenas demasiado largas
+// para el guion) producen la línea "error". Con 'conGuion' cada línea lleva además las
+// operaciones, con el mismo formato que el servidor: "<distancia> I<posA>:<posB> E<posA> ...".
+void procesarLote(std::istream& entrada, std::ostream& salida, int hilos, int paresPorGrupo, bool conGuion) {
+    if (hilos < 1 || paresPorGrupo < 1) {
+        throw std::invalid_argument("La cantidad de hilos y el tamaño de grupo deben ser positivos");
+    }
+    const long maximoEnVuelo = 4L * hilos;
+
+    std::mutex candado;
+    std::condition_variable hayTrabajo, hayResultado, hayEspacio;
+    std::deque<GrupoPares> pendientes;           // leídos, sin calcular
+    std::map<long, GrupoPares> terminados;       // calculados, esperando su turno de escritura
+    long enVuelo = 0;
+    bool finEntrada = false;
+
+    auto trabajador = [&]() {
+        MemoriaRapida memoria; // memoria de trabajo propia de la hebra
+        std::vector<EditOp> operaciones;
+        while (true) {
+            GrupoPares grupo;
+            {
+                std::unique_lock<std::mutex> guardia(candado);
+                hayTrabajo.wait(guardia, [&] { return !pendientes.empty() || finEntrada; });
+                if (pendientes.empty()) {
+                    return;
+                }
+                grupo = std::move(pendientes.front());
+                pendientes.pop_front();
+            }
+            size_t total = grupo.pares.size();
+            grupo.distancias.assign(total, 0);
+            grupo.validos.assign(total, true);
+            grupo.guiones.assign(conGuion ? total : 0, std::string());
+            for (size_t k = 0; k < total; ++k) {
+                auto inicio = std::chrono::steady_clock::now();
+                try {
+                    const std::string& A = grupo.pares[k].first;
+                    const std::string& B = grupo.pares[k].second;
+                    if (conGuion) {
+                        grupo.distancias[k] = guionEdicion(A, B, operaciones, memoria);
+                        agregarGuion(grupo.guiones[k], operaciones);
+                    } else {
+                        grupo.distancias[k] = minEditDistanceAuto(A, B, memoria);
+                    }
+                } catch (const std::exception&) {
+                    grupo.validos[k] = false;
+                }
+                auto fin = std::chrono::steady_clock::now();
+                grupo.latencias.agregar(std::chrono::duration<double, std::micro>(fin - inicio).count());
+            }
+            {
+                std::lock_guard<std::mutex> guardia(candado);
+                long indice = grupo.indice;
+                terminados.emplace(indice, std::move(grupo));
+            }
+            hayResultado.notify_one();
+        }
+    };
+
+    // La escritura va en su propia hebra para que la lectura nunca espere a la salida
+    HistogramaLatencias latencias;
+    long totalPares = 0;
+    long totalGrupos = -1; // se conoce al terminar la lectura
+    auto escritor = [&]() {
+        long siguiente = 0;
+        while (true) {
+            GrupoPares grupo;
+            {
+                std::unique_lock<std::mutex> guardia(candado);
+                hayResultado.wait(guardia, [&] {
+                    return terminados.count(siguiente) > 0 || (totalGrupos >= 0 && siguiente == totalGrupos);
+                });
+                if (totalGrupos >= 0 && siguiente == totalGrupos) {
+                    return;
+                }
+                grupo = std::move(terminados[siguiente]);
+                terminados.erase(siguiente);
+                --enVuelo;
+            }
+            hayEspacio.notify_one();
+            for (size_t k = 0; k < grupo.pares.size(); ++k) {
+                if (grupo.validos[k]) {
+                    salida << grupo.distancias[k];
+                    if (conGuion) {
+                        salida << grupo.guiones[k];
+                    }
+                    salida << '\n';
+                } else {
+                    salida << "error\n";
+                }
+            }
+            latencias.unir(grupo.latencias);
+            totalPares += grupo.pares.size();
+            ++siguiente;
+        }
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> trabajadores;
+    for (int t = 0; t < hilos; ++t) {
+        trabajadores.emplace_back(trabajador);
+    }
+    std::thread hebraEscritora(escritor);
+
+    // Lectura en la hebra principal
+    long indice = 0;
+    std::string linea;
+    GrupoPares grupo;
+    auto entregar = [&]() {
+        grupo.indice = indice++;
+        {
+            std::unique_lock<std::mutex> guardia(candado);
+            hayEspacio.wait(guardia, [&] { return enVuelo < maximoEnVuelo; });
+            ++enVuelo;
+            pendientes.push_back(std::move(grupo));
+        }
+        hayTrabajo.notify_one();
+        grupo = GrupoPares();
+    };
+    while (std::getline(entrada, linea)) {
+        // A va hasta el primer espacio o tabulación y B es el resto; cualquiera puede ser vacía,
+        // así cada línea de la entrada tiene exactamente una línea de salida
+        if (!linea.empty() && linea.back() == '\r') {
+            linea.pop_back();
+        }
+        size_t separador = linea.find_first_of(" \t");
+        if (separador == std::string::npos) {
+            grupo.pares.emplace_back(linea, std::string());
+        } else {
+            grupo.pares.emplace_back(linea.substr(0, separador), linea.substr(separador + 1));
+        }
+        if (static_cast<int>(grupo.pares.size()) == paresPorGrupo) {
+            entregar();
+        }
+    }
+    if (!grupo.pares.empty()) {
+        entregar();
+    }
+    {
+        std::lock_guard<std::mutex> guardia(candado);
+        finEntrada = true;
+        totalGrupos = indice;
+    }
+    hayTrabajo.notify_all();
+    hayResultado.notify_all();
+
+    for (std::thread& t : trabajadores) {
+        t.join();
+    }
+    hebraEscritora.join();
+    salida.flush();
+    auto fin = std::chrono::steady_clock::now();
+
+    // Resumen en stderr para no mezclarlo con las distancias
+    double segundos = std::chrono::duration<double>(fin - inicio).count();
+    std::cerr << "Pares procesados: " << totalPares << " en " << segundos << " s ("
+              << totalPares / segundos << " pares por segundo, " << hilos << " hebras)" << std::endl;
+    std::cerr << "Latencia por par (microsegundos, hasta ~9% por arriba): p50 " << latencias.percentil(0.50)
+              << ", p95 " << latencias.percentil(0.95) << ", p99 " << latencias.percentil(0.99) << ", máx "
+              << latencias.maximoUs() << std::endl;
+}
+
+// Generar una cadena aleatoria de letras minúsculas (para los experimentos)
+std::string generarCadenaAleatoria(int largo, unsigned semilla) {
+    std::mt19937 generador(semilla);
+    std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+    std::string cadena(largo, 'a');
+    for (char& c : cadena) {
+        c = static_cast<char>('a' + letra(generador));
+    }
+    return cadena;
+}
+
+// Memoria residente máxima del proceso en KB
+long memoriaPicoKB() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+// Generar un par (A, B) para la suite de experimentos. Tipos de carga:
+//  - aleatoria: A y B independientes
+//  - casi_igual: B es A con cerca de un 1% de sustituciones, inserciones y eliminaciones
+//  - repetitiva: A = "abab...", B igual pero con una 'c' en el medio
+//  - transposiciones: B es A con cada par de letras adyacentes intercambiado
+void generarCarga(const std::string& carga, int largo, unsigned semilla, std::string& A, std::string& B) {
+    std::mt19937 generador(semilla);
+    if (carga == "aleatoria") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = generarCadenaAleatoria(largo, semilla + 1);
+    } else if (carga == "casi_igual") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B.clear();
+        std::uniform_int_distribution<int> dado(0, 299);
+        std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+        for (char c : A) {
+            int tiro = dado(generador);
+            if (tiro == 0) {
+                B += static_cast<char>('a' + letra(generador)); // sustitución
+            } else if (tiro == 1) {
+                B += c;
+                B += static_cast<char>('a' + letra(generador)); // inserción
+            } else if (tiro != 2) {
+                B += c; // tiro == 2: eliminación
+            }
+        }
+    } else if (carga == "repetitiva") {
+        A.assign(largo, 'a');
+        for (int k = 1; k < largo; k += 2) {
+            A[k] = 'b';
+        }
+        B = A;
+        if (largo > 0) {
+            B[largo / 2] = 'c';
+        }
+    } else if (carga == "transposiciones") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = A;
+        for (int k = 0; k + 1 < largo; k += 2) {
+            std::swap(B[k], B[k + 1]);
+        }
+    } else {
+        throw std::invalid_argument("Carga desconocida: " + carga);
+    }
+}
+
+// Imprimir una fila CSV de la suite de experimentos a partir de los tiempos de cada repetición.
+// Columnas: programa,motor,carga,largo,semilla,repeticiones,mediana_us,p95_us,p99_us,
+// celdas_por_segundo,memoria_pico_kb,distancia
+void imprimirFilaBenchmark(const std::string& programa, const std::string& motor, const std::string& carga,
+                           int largo, unsigned semilla, std::vector<double> tiemposUs, double celdas, int distancia) {
+    std::sort(tiemposUs.begin(), tiemposUs.end());
+    auto percentil = [&](double p) {
+        size_t k = static_cast<size_t>(p * tiemposUs.size() + 0.999999);
+        return tiemposUs[std::min(tiemposUs.size() - 1, k == 0 ? 0 : k - 1)];
+    };
+    double mediana = percentil(0.50);
+    std::cout << programa << "," << motor << "," << carga << "," << largo << "," << semilla << ","
+              << tiemposUs.size() << "," << mediana << "," << percentil(0.95) << "," << percentil(0.99) << ","
+              << (mediana > 0 ? celdas / (mediana / 1e6) : 0.0) << "," << memoriaPicoKB() << "," << distancia << std::endl;
+}
+
+// Ejecutar un motor con calentamiento y repeticiones, y devolver los tiempos en microsegundos
+template <typename Motor>
+std::vector<double> medirRepeticiones(Motor motor, int calentamiento, int repeticiones, int& distancia) {
+    for (int r = 0; r < calentamiento; ++r) {
+        distancia = motor();
+    }
+    std::vector<double> tiempos;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto inicio = std::chrono::steady_clock::now();
+        distancia = motor();
+        auto fin = std::chrono::steady_clock::now();
+        tiempos.push_back(std::chrono::duration<double, std::micro>(fin - inicio).count());
+    }
+    return tiempos;
+}
+
+// Distancia de Damerau sin restricciones (Lowrance y Wagner). La transposición del DP de arriba
+// solo aplica a dos letras vecinas que no se vuelven a tocar (alineamiento óptimo de cadenas); acá
+// entre las dos letras transpuestas se pueden borrar letras de A e insertar letras de B:
+//   D[i][j] = D[i' - 1][j' - 1] + del(A[i' + 1 .. i - 1]) + trans(A[i], A[i']) + ins(B[j' + 1 .. j - 1])
+// con i' la última fila antes de i cuya letra es B[j] y j' la última columna antes de j cuya letra
+// es A[i] (índices desde 1). Como en el resto del programa, la coincidencia de letras distingue
+// mayúsculas (por eso las tablas de última aparición tienen 52 entradas) y los costos no.
+// Con costos que cumplen 2 * trans >= ins + del es la distancia mínima sobre cualquier secuencia de
+// operaciones; si no, sigue siendo el costo de un guion válido y nunca supera al DP de arriba.
+const int LETRAS_CON_MAYUSCULAS = 2 * ALPHABET_SIZE;
+
+inline int casillaLetra(char letra) {
+    unsigned char c = static_cast<unsigned char>(letra);
+    return std::islower(c) ? c - 'a' : ALPHABET_SIZE + (c - 'A');
+}
+
+// Solo se guardan las filas que la transposición puede volver a mirar: para cada letra, la fila
+// anterior a su última aparición en A. Con d letras distintas en A son d + 2 filas en total (las
+// de cada letra, la previa y la actual), y cuando una letra vuelve a aparecer su fila vieja pasa a
+// ser la actual, sin copiar nada.
+int minEditDistanceDamerau(const std::string& A, const std::string& B, MemoriaRapida& memoria) {
+    const int m = A.size();
+    const int n = B.size();
+    bool presente[LETRAS_CON_MAYUSCULAS] = {};
+    int distintas = 0;
+    for (char c : A) {
+        if (std::isalpha(static_cast<unsigned char>(c)) && !presente[casillaLetra(c)]) {
+            presente[casillaLetra(c)] = true;
+            ++distintas;
+        }
+    }
+
+    METRICA_INICIO(inicioReserva);
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(m + 1) + MemoriaRapida::bytesPara<int>(n + 1) +
+                     MemoriaRapida::bytesPara<uint8_t>(n) +
+                     MemoriaRapida::bytesPara<int>(static_cast<size_t>(distintas + 2) * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* borrarA = memoria.tomar<int>(m + 1);   // borrarA[i]: borrar A[0 .. i - 1]
+    int* insertarB = memoria.tomar<int>(n + 1); // insertarB[j]: insertar B[0 .. j - 1]
+    uint8_t* casillaB = memoria.tomar<uint8_t>(n);
+    int* filas = memoria.tomar<int>(static_cast<size_t>(distintas + 2) * (n + 1));
+    METRICA_FIN(inicioReserva, reservaNs);
+
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    borrarA[0] = 0;
+    for (int i = 0; i < m; ++i) {
+        borrarA[i + 1] = borrarA[i] + cost_delete_table[codA[i]];
+    }
+    insertarB[0] = 0;
+    for (int j = 0; j < n; ++j) {
+        insertarB[j + 1] = insertarB[j] + cost_insert_table[codB[j]];
+        casillaB[j] = casillaLetra(B[j]);
+    }
+
+    METRICA_INICIO(inicioLlenado);
+    int ultimaFila[LETRAS_CON_MAYUSCULAS] = {}; // 0: la letra todavía no aparece en A
+    int* filaDeLetra[LETRAS_CON_MAYUSCULAS] = {};
+    int filasUsadas = 2;
+    int* previa = filas;
+    int* actual = filas + (n + 1);
+    std::copy(insertarB, insertarB + n + 1, previa);
+
+    for (int i = 1; i <= m; ++i) {
+        const int* filaSub = cost_matrix[codA[i - 1]].data();
+        const int* filaTrans = cost_transpose_matrix[codA[i - 1]].data();
+        const int borrar = cost_delete_table[codA[i - 1]];
+        const char a = A[i - 1];
+        int ultimaColumna = 0; // última columna antes de j con B[j'] == A[i]
+        actual[0] = borrarA[i];
+        for (int j = 1; j <= n; ++j) {
+            const char b = B[j - 1];
+            int valor = std::min({actual[j - 1] + insertarB[j] - insertarB[j - 1], previa[j] + borrar,
+                                  previa[j - 1] + filaSub[codB[j - 1]]});
+            const int casilla = casillaB[j - 1];
+            const int iPrima = ultimaFila[casilla];
+            if (iPrima > 0 && ultimaColumna > 0) {
+                valor = std::min(valor, filaDeLetra[casilla][ultimaColumna - 1] + borrarA[i - 1] - borrarA[iPrima] +
+                                            filaTrans[codA[iPrima - 1]] + insertarB[j - 1] - insertarB[ultimaColumna]);
+            }
+            actual[j] = valor;
+            if (b == a) {
+                ultimaColumna = j;
+            }
+        }
+        // La fila previa (D[i - 1]) queda guardada para la letra A[i]; la que tenía antes se reutiliza
+        const int casilla = casillaLetra(a);
+        int* libre = filaDeLetra[casilla];
+        filaDeLetra[casilla] = previa;
+        ultimaFila[casilla] = i;
+        if (libre == nullptr) {
+            libre = filas + static_cast<size_t>(filasUsadas++) * (n + 1);
+        }
+        previa = actual;
+        actual = libre;
+    }
+    METRICA_FIN(inicioLlenado, llenadoNs);
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+    return previa[n];
+}
+
+int minEditDistanceDamerau(const std::string& A, const std::string& B) {
+    MemoriaRapida memoria;
+    return minEditDistanceDamerau(A, B, memoria);
+}
+
+// Distancia de Damerau sin restricciones con el guion de operaciones (tabla completa). Una
+// transposición con letras en medio se escribe como las eliminaciones E<posA> de las letras de A
+// entre las dos, luego T<posA> (que transpone A[posA] con la siguiente letra que queda) y las
+// inserciones I<posA>:<posB> entre las dos letras ya transpuestas (antes de A[posA]).
+int guionDamerau(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones, MemoriaRapida& memoria) {
+    const int m = A.size();
+    const int n = B.size();
+    if (1LL * (m + 1) * (n + 1) > MAXIMO_CELDAS_GUION) {
+        throw std::length_error("Cadenas demasiado largas para reconstruir las operaciones");
+    }
+    memoria.preparar(MemoriaRapida::bytesPara<int>(m) + MemoriaRapida::bytesPara<int>(n) +
+                     MemoriaRapida::bytesPara<int>(m + 1) + MemoriaRapida::bytesPara<int>(n + 1) +
+                     MemoriaRapida::bytesPara<int>(static_cast<size_t>(m + 1) * (n + 1)));
+    int* codA = memoria.tomar<int>(m);
+    int* codB = memoria.tomar<int>(n);
+    int* borrarA = memoria.tomar<int>(m + 1);
+    int* insertarB = memoria.tomar<int>(n + 1);
+    int* tabla = memoria.tomar<int>(static_cast<size_t>(m + 1) * (n + 1));
+    codificarCadena(A, codA);
+    codificarCadena(B, codB);
+    borrarA[0] = 0;
+    for (int i = 0; i < m; ++i) {
+        borrarA[i + 1] = borrarA[i] + cost_delete_table[codA[i]];
+    }
+    insertarB[0] = 0;
+    for (int j = 0; j < n; ++j) {
+        insertarB[j + 1] = insertarB[j] + cost_insert_table[codB[j]];
+    }
+    auto D = [&](int i, int j) -> int& { return tabla[static_cast<size_t>(i) * (n + 1) + j]; };
+    // Costo de la transposición que termina en (i, j), o INT_MAX si no hay una
+    auto transposicion = [&](int i, int j, int iPrima, int jPrima) {
+        if (iPrima == 0 || jPrima == 0) {
+            return INT_MAX;
+        }
+        return D(iPrima - 1, jPrima - 1) + borrarA[i - 1] - borrarA[iPrima] +
+               cost_transpose_matrix[codA[i - 1]][codA[iPrima - 1]] + insertarB[j - 1] - insertarB[jPrima];
+    };
+
+    int ultimaFila[LETRAS_CON_MAYUSCULAS] = {};
+    std::copy(insertarB, insertarB + n + 1, &D(0, 0));
+    for (int i = 1; i <= m; ++i) {
+        const int borrar = cost_delete_table[codA[i - 1]];
+        int ultimaColumna = 0;
+        D(i, 0) = borrarA[i];
+        for (int j = 1; j <= n; ++j) {
+            int valor = std::min({D(i, j - 1) + cost_insert_table[codB[j - 1]], D(i - 1, j) + borrar,
+                                  D(i - 1, j - 1) + cost_matrix[codA[i - 1]][codB[j - 1]]});
+            D(i, j) = std::min(valor, transposicion(i, j, ultimaFila[casillaLetra(B[j - 1])], ultimaColumna));
+            if (B[j - 1] == A[i - 1]) {
+                ultimaColumna = j;
+            }
+        }
+        ultimaFila[casillaLetra(A[i - 1])] = i;
+    }
+    METRICA_SUMAR(celdas, 1ULL * m * n);
+
+    // Recorrer la tabla hacia atrás eligiendo una operación que explique cada valor (las últimas
+    // apariciones se vuelven a buscar solo cuando hace falta una transposición)
+    operaciones.clear();
+    int i = m, j = n;
+    while (i > 0 || j > 0) {
+        if (i > 0 && j > 0 && D(i, j) == D(i - 1, j - 1) + cost_matrix[codA[i - 1]][codB[j - 1]]) {
+            if (A[i - 1] != B[j - 1]) {
+                operaciones.push_back({SUSTITUIR, i - 1, j - 1});
+            }
+            --i;
+            --j;
+        } else if (i > 0 && D(i, j) == D(i - 1, j) + cost_delete_table[codA[i - 1]]) {
+            operaciones.push_back({ELIMINAR, i - 1, j});
+            --i;
+        } else if (j > 0 && D(i, j) == D(i, j - 1) + cost_insert_table[codB[j - 1]]) {
+            operaciones.push_back({INSERTAR, i, j - 1});
+            --j;
+        } else {
+            int iPrima = i - 1;
+            while (iPrima > 0 && A[iPrima - 1] != B[j - 1]) {
+                --iPrima;
+            }
+            int jPrima = j - 1;
+            while (jPrima > 0 && B[jPrima - 1] != A[i - 1]) {
+                --jPrima;
+            }
+            if (transposicion(i, j, iPrima, jPrima) != D(i, j)) {
+                throw std::logic_error("guionDamerau: no se pudo reconstruir la tabla");
+            }
+            // Se agrega al revés: al final se invierte todo el guion
+            for (int k = j - 2; k >= jPrima; --k) {
+                operaciones.push_back({INSERTAR, iPrima - 1, k});
+            }
+            operaciones.push_back({TRANSPONER, iPrima - 1, jPrima - 1});
+            for (int k = i - 2; k >= iPrima; --k) {
+                operaciones.push_back({ELIMINAR, k, jPrima});
+            }
+            i = iPrima - 1;
+            j = jPrima - 1;
+        }
+    }
+    std::reverse(operaciones.begin(), operaciones.end());
+    return D(m, n);
+}
+
+// Escribir todo el texto en un descriptor (write puede escribir menos de lo pedido)
+bool escribirTodo(int descriptor, const char* datos, size_t largo) {
+    while (largo > 0) {
+        ssize_t escritos = ::write(descriptor, datos, largo);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        datos += escritos;
+        largo -= escritos;
+    }
+    return true;
+}
+
+// Servidor de distancias: carga las tablas una vez (las del programa) y atiende pedidos por un
+// socket Unix o por stdin/stdout. Protocolo de texto, una línea por pedido con los campos
+// separados por un espacio (un campo vacío es una cadena vacía):
+//   <id> d <A> <B>        distancia              ->  <id> <distancia>
+//   <id> k <k> <A> <B>    distancia acotada      ->  <id> <distancia> o <id> >k
+//   <id> s <A> <B>        guion de operaciones   ->  <id> <distancia> <op> <op> ...
+//   <id> u <A> <B>        lo mismo con Damerau sin restricciones (guionDamerau)
+// con las operaciones I<posA>:<posB> (insertar B[posB] antes de A[posA]), E<posA>, S<posA>:<posB>
+// y T<posA> (transponer A[posA] y A[posA + 1]). Un pedido inválido responde <id> error <motivo>.
+// Cada conexión puede tener muchos pedidos en vuelo: el lector los deja en una cola común y un
+// grupo de hebras (cada una con su MemoriaRapida) los resuelve en paralelo, así que las respuestas
+// pueden llegar en otro orden; el id las identifica.
+class ServidorDistancias {
+public:
+    ServidorDistancias(int hilos, int maximoEnVuelo) : maximoEnVuelo(maximoEnVuelo) {
+        if (hilos < 1 || maximoEnVuelo < 1) {
+            throw std::invalid_argument("La cantidad de hilos y de pedidos en vuelo deben ser positivas");
+        }
+        for (int t = 0; t < hilos; ++t) {
+            trabajadores.emplace_back([this] { trabajar(); });
+        }
+    }
+
+    ~ServidorDistancias() {
+        {
+            std::lock_guard<std::mutex> guardia(candado);
+            terminar = true;
+        }
+        hayPedido.notify_all();
+        for (std::thread& t : trabajadores) {
+            t.join();
+        }
+    }
+
+    // Atender una conexión: lee pedidos de 'entrada' hasta el fin y vuelve cuando todas las
+    // respuestas ya se escribieron en 'salida'
+    void atender(int entrada, int salida) {
+        auto conexion = std::make_shared<Conexion>();
+        conexion->salida = salida;
+        std::vector<char> buffer(1 << 16);
+        std::string pendiente;
+        while (true) {
+            ssize_t leidos = ::read(entrada, buffer.data(), buffer.size());
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos <= 0) break;
+            pendiente.append(buffer.data(), leidos);
+            size_t inicio = 0, fin;
+            while ((fin = pendiente.find('\n', inicio)) != std::string::npos) {
+                encolar(conexion, pendiente.substr(inicio, fin - inicio));
+                inicio = fin + 1;
+            }
+            pendiente.erase(0, inicio);
+        }
+        if (!pendiente.empty()) {
+            encolar(conexion, pendiente);
+        }
+        std::unique_lock<std::mutex> guardia(conexion->candado);
+        conexion->libre.wait(guardia, [&] { return conexion->enVuelo == 0; });
+    }
+
+    // Escuchar en un socket Unix; cada conexión tiene su hebra lectora y comparte las trabajadoras
+    void escuchar(const std::string& ruta) {
+        sockaddr_un direccion{};
+        if (ruta.size() >= sizeof(direccion.sun_path)) {
+            throw std::invalid_argument("Ruta de socket demasiado larga: " + ruta);
+        }
+        int servidor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (servidor < 0) {
+            throw std::runtime_error("No se pudo crear el socket");
+        }
+        direccion.sun_family = AF_UNIX;
+        std::strcpy(direccion.sun_path, ruta.c_str());
+        ::unlink(ruta.c_str());
+        if (::bind(servidor, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 ||
+            ::listen(servidor, 64) < 0) {
+            ::close(servidor);
+            throw std::runtime_error("No se pudo escuchar en el socket: " + ruta);
+        }
+        std::cerr << "Servidor escuchando en " << ruta << std::endl;
+        while (true) {
+            int cliente = ::accept(servidor, nullptr, nullptr);
+            if (cliente < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Error al aceptar una conexión");
+            }
+            std::thread([this, cliente] {
+                atender(cliente, cliente);
+                ::close(cliente);
+            }).detach();
+        }
+    }
+
+private:
+    struct Conexion {
+        int salida = -1;
+        std::mutex escritura; // una respuesta a la vez en el descriptor
+        std::mutex candado;
+        std::condition_variable libre;
+        int enVuelo = 0;
+    };
+
+    struct Pedido {
+        std::shared_ptr<Conexion> conexion;
+        std::string linea;
+    };
+
+    const int maximoEnVuelo; // por conexión; el lector espera si se llega a este número
+    std::vector<std::thread> trabajadores;
+    std::mutex candado;
+    std::condition_variable hayPedido;
+    std::deque<Pedido> cola;
+    bool terminar = false;
+
+    void encolar(const std::shared_ptr<Conexion>& conexion, std::string linea) {
+        if (!linea.empty() && linea.back() == '\r') {
+            linea.pop_back();
+        }
+        {
+            std::unique_lock<std::mutex> guardia(conexion->candado);
+            conexion->libre.wait(guardia, [&] { return conexion->enVuelo < maximoEnVuelo; });
+            ++conexion->enVuelo;
+        }
+        {
+            std::lock_guard<std::mutex> guardia(candado);
+            cola.push_back({conexion, std::move(linea)});
+        }
+        hayPedido.notify_one();
+    }
+
+    void trabajar() {
+        MemoriaRapida memoria; // memoria de trabajo propia de la hebra
+        std::vector<EditOp> operaciones;
+        std::vector<std::string> campos;
+        std::string respuesta;
+        while (true) {
+            Pedido pedido;
+            {
+                std::unique_lock<std::mutex> guardia(candado);
+                hayPedido.wait(guardia, [&] { return !cola.empty() || terminar; });
+                if (cola.empty()) {
+                    return;
+                }
+                pedido = std::move(cola.front());
+                cola.pop_front();
+            }
+            responder(pedido.linea, campos, operaciones, memoria, respuesta);
+            Conexion& conexion = *pedido.conexion;
+            {
+                std::lock_guard<std::mutex> guardia(conexion.escritura);
+                escribirTodo(conexion.salida, respuesta.data(), respuesta.size());
+            }
+            {
+                std::lock_guard<std::mutex> guardia(conexion.candado);
+                --conexion.enVuelo;
+            }
+            conexion.libre.notify_all();
+        }
+    }
+
+    static void responder(const std::string& linea, std::vector<std::string>& campos, std::vector<EditOp>& operaciones,
+                          MemoriaRapida& memoria, std::string& respuesta) {
+        campos.clear();
+        size_t inicio = 0;
+        while (true) {
+            size_t fin = linea.find(' ', inicio);
+            campos.push_back(linea.substr(inicio, fin == std::string::npos ? std::string::npos : fin - inicio));
+            if (fin == std::string::npos) break;
+            inicio = fin + 1;
+        }
+        respuesta = campos[0];
+        respuesta += ' ';
+        try {
+            const std::string tipo = campos.size() > 1 ? campos[1] : "";
+            if (tipo == "d" && campos.size() == 4) {
+                respuesta += std::to_string(minEditDistanceAuto(campos[2], campos[3], memoria));
+            } else if (tipo == "k" && campos.size() == 5) {
+                int distancia = minEditDistanceBounded(campos[3], campos[4], std::stoi(campos[2]), memoria);
+                respuesta += distancia == MAYOR_QUE_K ? ">k" : std::to_string(distancia);
+            } else if ((tipo == "s" || tipo == "u") && campos.size() == 4) {
+                int distancia = tipo == "s" ? guionEdicion(campos[2], campos[3], operaciones, memoria)
+                                            : guionDamerau(campos[2], campos[3], operaciones, memoria);
+                respuesta += std::to_string(distancia);
+                agregarGuion(respuesta, operaciones);
+            } else {
+                respuesta += "error pedido mal formado";
+            }
+        } catch (const std::exception& e) {
+            respuesta += "error ";
+            respuesta += e.what();
+        }
+        respuesta += '\n';
+    }
+};
+
+// Generador de carga para el servidor: abre 'conexiones' conexiones al socket y en cada una
+// manda 'pedidos' pedidos del tipo indicado con hasta 'enVuelo' sin responder, sobre pares de la
+// carga "casi_igual". Informa consultas por segundo y la latencia de cada pedido (desde que se
+// envía hasta que llega su respuesta).
+void generarCargaServidor(const std::string& ruta, int conexiones, int pedidos, int enVuelo, int largo,
+                          const std::string& tipo, unsigned semilla) {
+    if (conexiones < 1 || pedidos < 1 || enVuelo < 1) {
+        throw std::invalid_argument("Las conexiones, los pedidos y los pedidos en vuelo deben ser positivos");
+    }
+    if (tipo != "d" && tipo != "k" && tipo != "s") {
+        throw std::invalid_argument("Tipo de pedido desconocido: " + tipo);
+    }
+    // 64 pares distintos que se repiten, armados antes de medir
+    std::vector<std::string> pares;
+    for (int p = 0; p < 64; ++p) {
+        std::string A, B;
+        generarCarga("casi_igual", largo, semilla + p, A, B);
+        pares.push_back((tipo == "k" ? "k " + std::to_string(std::max(1, largo / 20)) : tipo) + " " + A + " " + B + "\n");
+    }
+
+    std::vector<std::vector<double>> latencias(conexiones);
+    std::atomic<long> errores{0};
+    auto cliente = [&](int c) {
+        int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un direccion{};
+        direccion.sun_family = AF_UNIX;
+        std::strncpy(direccion.sun_path, ruta.c_str(), sizeof(direccion.sun_path) - 1);
+        if (descriptor < 0 || ::connect(descriptor, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+            std::cerr << "No se pudo conectar a " << ruta << std::endl;
+            errores += pedidos;
+            if (descriptor >= 0) ::close(descriptor);
+            return;
+        }
+        std::vector<std::chrono::steady_clock::time_point> envio(pedidos);
+        std::mutex candado;
+        std::condition_variable hayLugar;
+        int sinRespuesta = 0;
+
+        std::thread emisor([&] {
+            std::string linea;
+            for (int q = 0; q < pedidos; ++q) {
+                {
+                    std::unique_lock<std::mutex> guardia(candado);
+                    hayLugar.wait(guardia, [&] { return sinRespuesta < enVuelo; });
+                    ++sinRespuesta;
+                    envio[q] = std::chrono::steady_clock::now();
+                }
+                linea = std::to_string(q) + " " + pares[(q + c) % pares.size()];
+                if (!escribirTodo(descriptor, linea.data(), linea.size())) {
+                    break;
+                }
+            }
+        });
+
+        std::vector<char> buffer(1 << 16);
+        std::string pendiente;
+        int recibidas = 0;
+        bool idInvalido = false;
+        while (recibidas < pedidos && !idInvalido) {
+            ssize_t leidos = ::read(descriptor, buffer.data(), buffer.size());
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos <= 0) break;
+            auto ahora = std::chrono::steady_clock::now();
+            pendiente.append(buffer.data(), leidos);
+            size_t inicio = 0, fin;
+            while ((fin = pendiente.find('\n', inicio)) != std::string::npos) {
+                int q = std::atoi(pendiente.c_str() + inicio);
+                if (q < 0 || q >= pedidos) {
+                    // Se corta la conexión: esta respuesta y las que faltan cuentan como errores
+                    std::cerr << "Respuesta con un id desconocido en la conexión " << c << std::endl;
+                    idInvalido = true;
+                    break;
+                }
+                size_t espacio = pendiente.find(' ', inicio);
+                if (espacio < fin && pendiente.compare(espacio + 1, 5, "error") == 0) {
+                    ++errores;
+                }
+                std::chrono::steady_clock::time_point enviado;
+                {
+                    std::lock_guard<std::mutex> guardia(candado);
+                    enviado = envio[q];
+                    --sinRespuesta;
+                }
+                hayLugar.notify_one();
+                latencias[c].push_back(std::chrono::duration<double, std::micro>(ahora - enviado).count());
+                ++recibidas;
+                inicio = fin + 1;
+            }
+            pendiente.erase(0, inicio);
+        }
+        if (recibidas < pedidos) {
+            errores += pedidos - recibidas;
+            ::shutdown(descriptor, SHUT_RDWR); // desbloquea al emisor si quedó esperando
+            {
+                std::lock_guard<std::mutex> guardia(candado);
+                sinRespuesta = 0;
+            }
+            hayLugar.notify_one();
+        }
+        emisor.join();
+        ::close(descriptor);
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> clientes;
+    for (int c = 0; c < conexiones; ++c) {
+        clientes.emplace_back(cliente, c);
+    }
+    for (std::thread& t : clientes) {
+        t.join();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::vector<double> todas;
+    for (const auto& l : latencias) {
+        todas.insert(todas.end(), l.begin(), l.end());
+    }
+    std::sort(todas.begin(), todas.end());
+    auto percentil = [&](double p) -> double {
+        if (todas.empty()) return 0.0;
+        return todas[std::min(todas.size() - 1, static_cast<size_t>(p * todas.size()))];
+    };
+    std::cout << "Consultas: " << todas.size() << " en " << segundos << " s (" << todas.size() / segundos
+              << " por segundo, " << conexiones << " conexiones, " << enVuelo << " en vuelo cada una, "
+              << errores << " errores)" << std::endl;
+    std::cout << "Latencia (microsegundos): p50 " << percentil(0.50) << ", p95 " << percentil(0.95) << ", p99 "
+              << percentil(0.99) << ", p99.9 " << percentil(0.999) << ", máx " << percentil(1.0) << std::endl;
+}
+
+// Matriz de distancias de todos contra todos, en un archivo binario que se puede mapear en memoria:
+// un encabezado de 64 bytes y después los valores fila por fila (uint16 si todas las distancias
+// caben, si no int32). Si los costos son simétricos (d(A, B) = d(B, A)) solo se guarda el triángulo
+// superior con la diagonal (la fila i tiene las columnas i..n-1); si no, la matriz completa. Un
+// archivo puede tener solo las filas [filaInicio, filaFin) (un fragmento, para repartir el trabajo
+// entre procesos o máquinas) y los fragmentos se unen después con unirMatrices.
+const char MAGIA_MATRIZ[8] = {'D', 'I', 'S', 'T', 'M', 'A', 'T', '1'};
+const uint32_t VERSION_MATRIZ = 1;
+
+struct alignas(64) EncabezadoMatriz {
+    char magia[8];
+    uint32_t version;
+    uint32_t bytesPorValor; // 2 o 4
+    uint64_t cadenas;       // n
+    uint64_t filaInicio;    // filas guardadas en este archivo: [filaInicio, filaFin)
+    uint64_t filaFin;
+    uint64_t sumaEntrada;   // FNV-1a de las cadenas y de las tablas de costos
+    uint32_t simetrica;     // 1: triángulo superior, 0: matriz completa
+};
+
+static_assert(sizeof(EncabezadoMatriz) == 64, "El encabezado de la matriz debe ocupar 64 bytes");
+
+// La distancia es simétrica si insertar y eliminar cada letra cuestan lo mismo y las matrices de
+// sustitución y transposición son simétricas (el camino inverso usa las operaciones opuestas)
+bool costosSimetricos() {
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        if (cost_insert_table[a] != cost_delete_table[a]) {
+            return false;
+        }
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            if (cost_matrix[a][b] != cost_matrix[b][a] || cost_transpose_matrix[a][b] != cost_transpose_matrix[b][a]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Suma de verificación de la entrada: los fragmentos solo se pueden unir si salen de las mismas
+// cadenas con los mismos costos
+uint64_t sumaEntradaMatriz(const std::vector<std::string>& cadenas) {
+    uint64_t suma = 1469598103934665603ULL;
+    auto agregar = [&suma](const void* datos, size_t largo) {
+        const unsigned char* p = static_cast<const unsigned char*>(datos);
+        for (size_t k = 0; k < largo; ++k) {
+            suma = (suma ^ p[k]) * 1099511628211ULL;
+        }
+    };
+    for (const std::string& cadena : cadenas) {
+        agregar(cadena.data(), cadena.size());
+        agregar("\n", 1);
+    }
+    agregar(cost_insert_table.data(), sizeof(cost_insert_table));
+    agregar(cost_delete_table.data(), sizeof(cost_delete_table));
+    agregar(cost_matrix.data(), sizeof(cost_matrix));
+    agregar(cost_transpose_matrix.data(), sizeof(cost_transpose_matrix));
+    return suma;
+}
+
+// Posición (en valores, desde el comienzo de la matriz completa) del primer valor de la fila i
+uint64_t inicioFilaMatriz(uint64_t i, uint64_t n, bool simetrica) {
+    return simetrica ? i * n - i * (i - 1) / 2 : i * n;
+}
+
+// Matriz (o fragmento) de distancias mapeada en memoria, solo lectura
+class MatrizDistancias {
+public:
+    explicit MatrizDistancias(const std::string& ruta) {
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error al abrir la matriz: " + ruta);
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(EncabezadoMatriz))) {
+            close(descriptor);
+            throw std::runtime_error("Matriz incompleta: " + ruta);
+        }
+        tamano = info.st_size;
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("No se pudo mapear la matriz: " + ruta);
+        }
+        datos = static_cast<const unsigned char*>(mapa);
+        encabezado = *reinterpret_cast<const EncabezadoMatriz*>(datos);
+        const EncabezadoMatriz& e = encabezado;
+        bool valido = std::memcmp(e.magia, MAGIA_MATRIZ, sizeof(MAGIA_MATRIZ)) == 0 && e.version == VERSION_MATRIZ &&
+                      (e.bytesPorValor == 2 || e.bytesPorValor == 4) && e.filaInicio <= e.filaFin && e.filaFin <= e.cadenas;
+        if (valido) {
+            primerValor = inicioFilaMatriz(e.filaInicio, e.cadenas, e.simetrica);
+            valores = inicioFilaMatriz(e.filaFin, e.cadenas, e.simetrica) - primerValor;
+            valido = tamano == sizeof(EncabezadoMatriz) + valores * e.bytesPorValor;
+        }
+        if (!valido) {
+            munmap(const_cast<unsigned char*>(datos), tamano);
+            throw std::runtime_error("El archivo '" + ruta + "' no es una matriz de distancias válida");
+        }
+    }
+
+    ~MatrizDistancias() {
+        munmap(const_cast<unsigned char*>(datos), tamano);
+    }
+
+    MatrizDistancias(const MatrizDistancias&) = delete;
+    MatrizDistancias& operator=(const MatrizDistancias&) = delete;
+
+    // Distancia de la cadena i a la cadena j (en la matriz simétrica se lee la celda (min, max))
+    int distancia(uint64_t i, uint64_t j) const {
+        if (encabezado.simetrica && j < i) {
+            std::swap(i, j);
+        }
+        if (i < encabezado.filaInicio || i >= encabezado.filaFin || j >= encabezado.cadenas) {
+            throw std::out_of_range("La celda (" + std::to_string(i) + ", " + std::to_string(j) + ") no está en este archivo");
+        }
+        uint64_t indice = inicioFilaMatriz(i, encabezado.cadenas, encabezado.simetrica) - primerValor +
+                          (encabezado.simetrica ? j - i : j);
+        const unsigned char* valor = datos + sizeof(EncabezadoMatriz) + indice * encabezado.bytesPorValor;
+        return encabezado.bytesPorValor == 2 ? *reinterpret_cast<const uint16_t*>(valor)
+                                             : *reinterpret_cast<const int32_t*>(valor);
+    }
+
+    // Los valores guardados, tal cual (para unir fragmentos)
+    const unsigned char* bytesValores() const {
+        return datos + sizeof(EncabezadoMatriz);
+    }
+
+    EncabezadoMatriz encabezado;
+    uint64_t valores = 0; // cantidad de valores en este archivo
+
+private:
+    const unsigned char* datos = nullptr;
+    size_t tamano = 0;
+    uint64_t primerValor = 0;
+};
+
+// Calcular las filas [filaInicio, filaFin) de la matriz de distancias de 'cadenas' y escribirlas en
+// 'salida'. El trabajo se reparte en bloques de tamBloque x tamBloque pares (las cadenas de un
+// bloque se reutilizan mientras están en caché) que las hebras toman de un contador común; cada
+// hebra tiene su MemoriaRapida y escribe directo en el archivo mapeado.
+void calcularMatriz(const std::vector<std::string>& cadenas, const std::string& salida, uint64_t filaInicio,
+                    uint64_t filaFin, int hilos, int tamBloque) {
+    const uint64_t n = cadenas.size();
+    if (hilos < 1 || tamBloque < 1) {
+        throw std::invalid_argument("La cantidad de hilos y el tamaño de bloque deben ser positivos");
+    }
+    if (filaInicio > filaFin || filaFin > n) {
+        throw std::invalid_argument("Rango de filas inválido");
+    }
+    // Validar todo antes de empezar, y acotar las distancias para elegir el ancho de los valores
+    long long mayorBorrado = 0, mayorInsercion = 0;
+    for (size_t k = 0; k < cadenas.size(); ++k) {
+        long long borrar = 0, insertar = 0;
+        for (char c : cadenas[k]) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (!std::isalpha(u)) {
+                throw std::invalid_argument("La cadena " + std::to_string(k) + " tiene un carácter inválido");
+            }
+            borrar += cost_delete_table[std::tolower(u) - 'a'];
+            insertar += cost_insert_table[std::tolower(u) - 'a'];
+        }
+        mayorBorrado = std::max(mayorBorrado, borrar);
+        mayorInsercion = std::max(mayorInsercion, insertar);
+    }
+    // Borrar A completa e insertar B completa acota la distancia por arriba; por abajo solo vale 0
+    // si no hay costos negativos, y si los hay se guardan valores de 32 bits con signo
+    const long long cota = mayorBorrado + mayorInsercion;
+    if (cota > std::numeric_limits<int32_t>::max()) {
+        throw std::overflow_error("Las distancias podrían no caber en 32 bits");
+    }
+    const bool simetrica = costosSimetricos();
+
+    EncabezadoMatriz encabezado{};
+    std::memcpy(encabezado.magia, MAGIA_MATRIZ, sizeof(MAGIA_MATRIZ));
+    encabezado.version = VERSION_MATRIZ;
+    encabezado.bytesPorValor = !costos_negativos && cota <= std::numeric_limits<uint16_t>::max() ? 2 : 4;
+    encabezado.cadenas = n;
+    encabezado.filaInicio = filaInicio;
+    encabezado.filaFin = filaFin;
+    encabezado.sumaEntrada = sumaEntradaMatriz(cadenas);
+    encabezado.simetrica = simetrica;
+    const uint64_t primerValor = inicioFilaMatriz(filaInicio, n, simetrica);
+    const uint64_t valores = inicioFilaMatriz(filaFin, n, simetrica) - primerValor;
+    const size_t tamano = sizeof(EncabezadoMatriz) + valores * encabezado.bytesPorValor;
+
+    int descriptor = open(salida.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0 || ftruncate(descriptor, tamano) != 0) {
+        if (descriptor >= 0) close(descriptor);
+        throw std::runtime_error("Error al crear el archivo: " + salida);
+    }
+    void* mapa = mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapa == MAP_FAILED) {
+        throw std::runtime_error("No se pudo mapear el archivo: " + salida);
+    }
+    unsigned char* datos = static_cast<unsigned char*>(mapa);
+    std::memcpy(datos, &encabezado, sizeof(encabezado));
+    uint16_t* valores16 = reinterpret_cast<uint16_t*>(datos + sizeof(EncabezadoMatriz));
+    int32_t* valores32 = reinterpret_cast<int32_t*>(datos + sizeof(EncabezadoMatriz));
+
+    // Bloques: filas del rango por columnas; en la matriz simétrica solo los que tocan j >= i
+    std::vector<std::pair<uint64_t, uint64_t>> bloques;
+    for (uint64_t fila = filaInicio; fila < filaFin; fila += tamBloque) {
+        uint64_t desde = simetrica ? fila / tamBloque * tamBloque : 0;
+        for (uint64_t columna = desde; columna < n; columna += tamBloque) {
+            bloques.emplace_back(fila, columna);
+        }
+    }
+    std::atomic<size_t> siguiente{0};
+    std::atomic<uint64_t> pares{0};
+    std::exception_ptr error;
+    std::mutex candadoError;
+    auto trabajador = [&]() {
+        MemoriaRapida memoria;
+        uint64_t calculados = 0;
+        try {
+            for (size_t b = siguiente++; b < bloques.size(); b = siguiente++) {
+                uint64_t finFila = std::min<uint64_t>(bloques[b].first + tamBloque, filaFin);
+                uint64_t finColumna = std::min<uint64_t>(bloques[b].second + tamBloque, n);
+                for (uint64_t i = bloques[b].first; i < finFila; ++i) {
+                    uint64_t j = simetrica ? std::max(i, bloques[b].second) : bloques[b].second;
+                    uint64_t base = inicioFilaMatriz(i, n, simetrica) - primerValor - (simetrica ? i : 0);
+                    for (; j < finColumna; ++j) {
+                        int d = minEditDistanceAuto(cadenas[i], cadenas[j], memoria);
+                        if (encabezado.bytesPorValor == 2) {
+                            valores16[base + j] = static_cast<uint16_t>(d);
+                        } else {
+                            valores32[base + j] = d;
+                        }
+                        ++calculados;
+                    }
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guardia(candadoError);
+            error = std::current_exception();
+            siguiente = bloques.size(); // las demás hebras terminan su bloque y paran
+        }
+        pares += calculados;
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> hebras;
+    for (int t = 0; t < hilos; ++t) {
+        hebras.emplace_back(trabajador);
+    }
+    for (std::thread& t : hebras) {
+        t.join();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    msync(mapa, tamano, MS_SYNC);
+    munmap(mapa, tamano);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    std::cout << "Filas " << filaInicio << ".." << filaFin << " de " << n << " cadenas ("
+              << (simetrica ? "costos simétricos: triángulo superior" : "costos asimétricos: matriz completa") << ", "
+              << encabezado.bytesPorValor << " bytes por valor): " << pares << " pares en " << segundos << " s ("
+              << pares / segundos << " pares por segundo, " << hilos << " hebras)" << std::endl;
+}
+
+// Unir fragmentos de una misma matriz (mismas cadenas y costos) que juntos cubren todas las filas
+void unirMatrices(const std::string& salida, const std::vector<std::string>& rutas) {
+    std::vector<std::unique_ptr<MatrizDistancias>> fragmentos;
+    for (const std::string& ruta : rutas) {
+        fragmentos.emplace_back(new MatrizDistancias(ruta));
+    }
+    if (fragmentos.empty()) {
+        throw std::invalid_argument("No hay fragmentos para unir");
+    }
+    std::sort(fragmentos.begin(), fragmentos.end(), [](const auto& x, const auto& y) {
+        return x->encabezado.filaInicio < y->encabezado.filaInicio;
+    });
+    const EncabezadoMatriz& primero = fragmentos[0]->encabezado;
+    uint64_t filaEsperada = 0;
+    for (const auto& fragmento : fragmentos) {
+        const EncabezadoMatriz& e = fragmento->encabezado;
+        if (e.cadenas != primero.cadenas || e.simetrica != primero.simetrica || e.bytesPorValor != primero.bytesPorValor ||
+            e.sumaEntrada != primero.sumaEntrada) {
+            throw std::runtime_error("Los fragmentos no son de la misma matriz (cadenas o costos distintos)");
+        }
+        if (e.filaInicio != filaEsperada) {
+            throw std::runtime_error("Faltan o se repiten filas desde la fila " + std::to_string(filaEsperada));
+        }
+        filaEsperada = e.filaFin;
+    }
+    if (filaEsperada != primero.cadenas) {
+        throw std::runtime_error("Faltan las filas desde la " + std::to_string(filaEsperada));
+    }
+
+    std::ofstream archivo(salida, std::ios::binary);
+    if (!archivo.is_open()) {
+        throw std::runtime_error("Error al crear el archivo: " + salida);
+    }
+    EncabezadoMatriz encabezado = primero;
+    encabezado.filaInicio = 0;
+    encabezado.filaFin = primero.cadenas;
+    archivo.write(reinterpret_cast<const char*>(&encabezado), sizeof(encabezado));
+    for (const auto& fragmento : fragmentos) {
+        archivo.write(reinterpret_cast<const char*>(fragmento->bytesValores()),
+                      fragmento->valores * fragmento->encabezado.bytesPorValor);
+    }
+    if (!archivo) {
+        throw std::runtime_error("Error al escribir el archivo: " + salida);
+    }
+    std::cout << "Se unieron " << fragmentos.size() << " fragmentos en '" << salida << "' (" << primero.cadenas
+              << " cadenas)." << std::endl;
+}
+
+// Función principal
+int main(int argc, char* argv[]) {
+#ifdef DP_METRICAS
+    std::atexit(exportarMetricas);
+#endif
+    try {
+        std::string modo = argc > 1 ? argv[1] : "";
+
+        // Generador de carga para el servidor (no necesita las tablas):
+        // ./DP --carga <socket> <conexiones> <pedidos por conexión> <en vuelo> <largo> [d|k|s] [semilla]
+        if (modo == "--carga") {
+            if (argc < 7) {
+                throw std::invalid_argument("Uso: --carga <socket> <conexiones> <pedidos por conexión> <en vuelo> <largo> [d|k|s] [semilla]");
+            }
+            generarCargaServidor(argv[2], std::stoi(argv[3]), std::stoi(argv[4]), std::stoi(argv[5]), std::stoi(argv[6]),
+                                 argc > 7 ? argv[7] : "d", argc > 8 ? std::stoul(argv[8]) : 1);
+            return 0;
+        }
+        // Unir fragmentos de la matriz de distancias: ./DP --unir-matriz <salida.bin> <fragmento.bin> ...
+        if (modo == "--unir-matriz") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --unir-matriz <salida.bin> <fragmento.bin> ...");
+            }
+            unirMatrices(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+            return 0;
+        }
+        // Leer una celda de una matriz (o fragmento): ./DP --consultar-matriz <matriz.bin> <i> <j>
+        if (modo == "--consultar-matriz") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --consultar-matriz <matriz.bin> <i> <j>");
+            }
+            MatrizDistancias matriz(argv[2]);
+            std::cout << matriz.distancia(std::stoull(argv[3]), std::stoull(argv[4])) << std::endl;
+            return 0;
+        }
+        // Con el servidor en stdin/stdout, los mensajes de la carga de costos van a stderr
+        if (modo == "--servidor" && argc > 2 && std::string(argv[2]) == "-") {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        }
+
+        // Compilar perfiles binarios: ./DP --compilar-perfiles <salida.bin> <nombre>=<carpeta> ...
+        if (modo == "--compilar-perfiles") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --compilar-perfiles <salida.bin> <nombre>=<carpeta> ...");
+            }
+            std::vector<std::pair<std::string, std::string>> entradas;
+            for (int k = 3; k < argc; ++k) {
+                std::string entrada = argv[k];
+                size_t igual = entrada.find('=');
+                if (igual == std::string::npos) {
+                    throw std::invalid_argument("Se esperaba <nombre>=<carpeta>: " + entrada);
+                }
+                entradas.emplace_back(entrada.substr(0, igual), entrada.substr(igual + 1));
+            }
+            compilarPerfiles(argv[2], entradas);
+            return 0;
+        }
+
+        // Alfabeto propio: ./DP --alfabeto <simbolos|bytes> <carpeta|unitario> <A> <B>
+        // Usa sus propias tablas (del tamaño del alfabeto), no las de letras.
+        if (modo == "--alfabeto") {
+            if (argc < 6) {
+                throw std::invalid_argument("Uso: --alfabeto <simbolos|bytes> <carpeta|unitario> <A> <B>");
+            }
+            Alfabeto alfabeto(argv[2]);
+            std::string carpeta = argv[3];
+            CostosAlfabeto costos = carpeta == "unitario" ? CostosAlfabeto::unitarios(alfabeto)
+                                                          : CostosAlfabeto::cargar(carpeta, alfabeto);
+            std::vector<uint8_t> A = alfabeto.codificar(argv[4]);
+            std::vector<uint8_t> B = alfabeto.codificar(argv[5]);
+            std::cout << "Distancia con un alfabeto de " << alfabeto.tamano() << " símbolos: "
+                      << minEditDistanceAlfabeto(A, B, costos) << std::endl;
+            return 0;
+        }
+
+        // Secuencias de ADN empaquetadas: ./DP --adn <carpeta|unitario> <a.fasta> <b.fasta>
+        // Las tablas de la carpeta son para el alfabeto ACGT (4 y 4x4 valores).
+        if (modo == "--adn") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --adn <carpeta|unitario> <a.fasta> <b.fasta>");
+            }
+            Alfabeto alfabeto("ACGT");
+            std::string carpeta = argv[2];
+            CostosAlfabeto costos = carpeta == "unitario" ? CostosAlfabeto::unitarios(alfabeto)
+                                                          : CostosAlfabeto::cargar(carpeta, alfabeto);
+            SecuenciaADN A = leerSecuenciaADN(argv[3]);
+            SecuenciaADN B = leerSecuenciaADN(argv[4]);
+            std::cout << "Secuencias de " << A.size() << " y " << B.size() << " bases: "
+                      << A.bytes() + B.bytes() << " bytes empaquetadas (" << A.size() + B.size()
+                      << " como std::string)" << std::endl;
+
+            auto inicio = std::chrono::steady_clock::now();
+            int distancia = minEditDistanceAlfabeto(A, B, costos);
+            auto fin = std::chrono::steady_clock::now();
+            std::cout << "Distancia: " << distancia << " en "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()
+                      << " microsegundos" << std::endl;
+            return 0;
+        }
+
+        // Cargar las tablas y matrices de costos: desde un perfil binario si se indica con
+        // PERFIL_COSTOS=<archivo.bin>:<nombre>, o desde los archivos de texto
+        METRICA_INICIO(inicioCarga);
+        std::unique_ptr<ArchivoPerfiles> archivoPerfiles;
+        const char* perfil = std::getenv("PERFIL_COSTOS");
+        if (perfil != nullptr) {
+            std::string valor = perfil;
+            size_t separador = valor.rfind(':');
+            if (separador == std::string::npos) {
+                throw std::invalid_argument("PERFIL_COSTOS debe ser <archivo.bin>:<nombre>");
+            }
+            archivoPerfiles.reset(new ArchivoPerfiles(valor.substr(0, separador)));
+            archivoPerfiles->usar(valor.substr(separador + 1));
+            std::cout << "Perfil de costos '" << valor.substr(separador + 1) << "' cargado." << std::endl;
+        } else {
+            cargar_matriz_costos("cost_replace.txt");
+            cargarTablaCostos("cost_insert.txt");
+            cargarTablaCostosEliminacion("cost_delete.txt");
+            cargarMatrizCostosTransposicion("cost_transpose.txt");
+        }
+        detectarCostosUniformes();
+        revisarCostosNegativos();
+        prepararRecorte();
+        METRICA_FIN(inicioCarga, cargaNs);
+
+        // Tiempo de carga: ./DP --bench-carga <perfiles.bin> <nombre> <repeticiones>
+        // Compara los cargadores de texto con el perfil binario (abrir + verificar + copiar)
+        if (modo == "--bench-carga") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --bench-carga <perfiles.bin> <nombre> <repeticiones>");
+            }
+            int repeticiones = std::stoi(argv[4]);
+            std::streambuf* salidaOriginal = std::cout.rdbuf(nullptr); // silenciar los cargadores
+            auto inicio = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeticiones; ++r) {
+                cargar_matriz_costos("cost_replace.txt");
+                cargarTablaCostos("cost_insert.txt");
+                cargarTablaCostosEliminacion("cost_delete.txt");
+                cargarMatrizCostosTransposicion("cost_transpose.txt");
+            }
+            auto medio = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeticiones; ++r) {
+                ArchivoPerfiles archivo(argv[2]);
+                archivo.usar(argv[3]);
+            }
+            auto fin = std::chrono::steady_clock::now();
+            ArchivoPerfiles archivo(argv[2]);
+            const PerfilBinario& elegido = archivo.buscar(argv[3]);
+            auto inicioSuma = std::chrono::steady_clock::now();
+            volatile uint64_t suma = 0; // volatile para que el compilador no elimine el ciclo
+            for (int r = 0; r < repeticiones; ++r) {
+                suma = sumaPerfil(elegido);
+            }
+            (void)suma;
+            auto finSuma = std::chrono::steady_clock::now();
+            std::cout.rdbuf(salidaOriginal);
+
+            auto porCarga = [&](std::chrono::steady_clock::duration d) {
+                return std::chrono::duration<double, std::micro>(d).count() / repeticiones;
+            };
+            std::cout << "Archivos de texto: " << porCarga(medio - inicio) << " microsegundos por carga" << std::endl;
+            std::cout << "Perfil binario (mmap + verificación + copia): " << porCarga(fin - medio) << " microsegundos por carga" << std::endl;
+            std::cout << "Solo verificación de la suma: " << porCarga(finSuma - inicioSuma) << " microsegundos" << std::endl;
+            return 0;
+        }
+
+        // Suite de experimentos (una fila CSV por ejecución, ver benchmark.sh):
+        // ./DP --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>
+        // Motores: dp, lineal, rapida, angosta, diagonal, auto, damerau (sin restricciones)
+        if (modo == "--bench-suite") {
+            if (argc < 8) {
+                throw std::invalid_argument("Uso: --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>");
+            }
+            std::string motor = argv[2];
+            std::string carga = argv[3];
+            int largo = std::stoi(argv[4]);
+            unsigned semilla = std::stoul(argv[5]);
+            std::string A, B;
+            generarCarga(carga, largo, semilla, A, B);
+
+            int (*funcion)(const std::string&, const std::string&) = nullptr;
+            if (motor == "dp") funcion = minEditDistance;
+            else if (motor == "lineal") funcion = minEditDistanceLineal;
+            else if (motor == "rapida") funcion = minEditDistanceRapida;
+            else if (motor == "angosta") funcion = minEditDistanceAngosta;
+            else if (motor == "diagonal") funcion = minEditDistanceDiagonal;
+            else if (motor == "auto") funcion = minEditDistanceAuto;
+            else if (motor == "damerau") funcion = minEditDistanceDamerau;
+            else throw std::invalid_argument("Motor desconocido: " + motor);
+
+            int distancia = 0;
+            std::vector<double> tiempos = medirRepeticiones([&] { return funcion(A, B); },
+                                                            std::stoi(argv[7]), std::stoi(argv[6]), distancia);
+            imprimirFilaBenchmark("DP", motor, carga, largo, semilla, tiempos,
+                                  static_cast<double>(A.size()) * B.size(), distancia);
+            return 0;
+        }
+
+        // Experimento de memoria: ./DP --bench-memoria <completa|lineal> <largo_A> <largo_B>
+        // Se ejecuta una versión por proceso para que la memoria máxima no se mezcle.
+        if (modo == "--bench-memoria") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --bench-memoria <completa|lineal> <largo_A> <largo_B>");
+            }
+            std::string version = argv[2];
+            std::string A = generarCadenaAleatoria(std::stoi(argv[3]), 1);
+            std::string B = generarCadenaAleatoria(std::stoi(argv[4]), 2);
+            long memoriaBase = memoriaPicoKB();
+
+            auto inicio = std::chrono::high_resolution_clock::now();
+            int result = version == "lineal" ? minEditDistanceLineal(A, B) : minEditDistance(A, B);
+            auto fin = std::chrono::high_resolution_clock::now();
+            auto duracion = std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio);
+
+            std::cout << "Versión: " << version << std::endl;
+            std::cout << "Distancia mínima de edición: " << result << std::endl;
+            std::cout << "El código tardó: " << duracion.count() << " microsegundos." << std::endl;
+            std::cout << "Memoria máxima: " << memoriaPicoKB() << " KB (base " << memoriaBase << " KB)" << std::endl;
+            return 0;
+        }
+
+        // Microbenchmark del ciclo interno: ./DP --bench-celdas <largo> <repeticiones>
+        if (modo == "--bench-celdas") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-celdas <largo> <repeticiones>");
+            }
+            int largo = std::stoi(argv[2]);
+            int repeticiones = std::stoi(argv[3]);
+            std::string A = generarCadenaAleatoria(largo, 1);
+            std::string B = generarCadenaAleatoria(largo, 2);
+            double celdas = static_cast<double>(largo) * largo * repeticiones;
+
+            auto medir = [&](const std::string& nombre, int (*motor)(const std::string&, const std::string&)) {
+                int result = 0;
+                auto inicio = std::chrono::high_resolution_clock::now();
+                for (int r = 0; r < repeticiones; ++r) {
+                    result = motor(A, B);
+                }
+                auto fin = std::chrono::high_resolution_clock::now();
+                double segundos = std::chrono::duration<double>(fin - inicio).count();
+                std::cout << nombre << ": distancia " << result << ", " << celdas / segundos << " celdas por segundo" << std::endl;
+            };
+            medir("minEditDistance", minEditDistance);
+            medir("minEditDistanceRapida", minEditDistanceRapida);
+            medir("minEditDistanceDiagonal (" + nombreNucleoDiagonal() + ")", minEditDistanceDiagonal);
+            medir("minEditDistanceDamerau (sin restricciones)", minEditDistanceDamerau);
+            medir(costo_uniforme > 0 ? "minEditDistanceAuto (vectores de bits)" : "minEditDistanceAuto (DP general)", minEditDistanceAuto);
+            return 0;
+        }
+
+        // Damerau sin restricciones contra el DP con transposición de vecinas: ./DP --damerau <A> <B>
+        // Muestra las dos distancias y el guion de operaciones de Damerau sin restricciones.
+        if (modo == "--damerau") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --damerau <A> <B>");
+            }
+            std::string A = argv[2];
+            std::string B = argv[3];
+            MemoriaRapida memoria;
+            std::vector<EditOp> operaciones;
+            int distancia = guionDamerau(A, B, operaciones, memoria);
+            std::cout << "Transposición de vecinas (minEditDistance): " << minEditDistanceRapida(A, B, memoria) << std::endl;
+            std::cout << "Damerau sin restricciones: " << distancia << std::endl;
+            for (const EditOp& op : operaciones) {
+                switch (op.tipo) {
+                    case INSERTAR:
+                        std::cout << "  insertar '" << B[op.posB] << "' antes de A[" << op.posA << "]" << std::endl;
+                        break;
+                    case ELIMINAR:
+                        std::cout << "  eliminar A[" << op.posA << "] = '" << A[op.posA] << "'" << std::endl;
+                        break;
+                    case SUSTITUIR:
+                        std::cout << "  sustituir A[" << op.posA << "] = '" << A[op.posA] << "' por '" << B[op.posB] << "'" << std::endl;
+                        break;
+                    case TRANSPONER:
+                        std::cout << "  transponer A[" << op.posA << "] = '" << A[op.posA] << "' con la letra siguiente" << std::endl;
+                        break;
+                }
+            }
+            return 0;
+        }
+
+        // Etapa de reducción sobre pares casi iguales: ./DP --bench-recorte <largo> <pares> [cambios]
+        // B es A con 'cambios' ediciones al azar (sustitución, inserción, eliminación o transposición);
+        // compara minEditDistanceRapida directo contra la misma con la etapa de reducción delante.
+        if (modo == "--bench-recorte") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-recorte <largo> <pares> [cambios]");
+            }
+            int largo = std::stoi(argv[2]);
+            int totalPares = std::stoi(argv[3]);
+            int cambios = argc > 4 ? std::stoi(argv[4]) : 1;
+            std::mt19937 generador(7);
+            std::vector<std::pair<std::string, std::string>> pares;
+            double celdasCompletas = 0, celdasCentrales = 0;
+            for (int p = 0; p < totalPares; ++p) {
+                std::string A = generarCadenaAleatoria(largo, p + 1), B = A;
+                for (int c = 0; c < cambios && !B.empty(); ++c) {
+                    int posicion = generador() % B.size();
+                    char letra = static_cast<char>('a' + generador() % ALPHABET_SIZE);
+                    switch (generador() % 4) {
+                        case 0: B[posicion] = letra; break;
+                        case 1: B.insert(B.begin() + posicion, letra); break;
+                        case 2: B.erase(B.begin() + posicion); break;
+                        default:
+                            if (posicion + 1 < static_cast<int>(B.size())) std::swap(B[posicion], B[posicion + 1]);
+                            break;
+                    }
+                }
+                Recorte r = recortarComunes(A, B);
+                celdasCompletas += static_cast<double>(A.size()) * B.size();
+                celdasCentrales += static_cast<double>(A.size() - r.prefijo - r.sufijo) * (B.size() - r.prefijo - r.sufijo);
+                pares.emplace_back(std::move(A), std::move(B));
+            }
+            MemoriaRapida memoria;
+            auto medir = [&](const std::string& nombre, auto motor) {
+                long long suma = 0;
+                auto inicio = std::chrono::steady_clock::now();
+                for (const auto& par : pares) {
+                    suma += motor(par.first, par.second);
+                }
+                double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                std::cout << nombre << ": " << pares.size() / segundos << " pares por segundo (suma de distancias "
+                          << suma << ")" << std::endl;
+            };
+            auto rapida = [&](const std::string& a, const std::string& b) { return minEditDistanceRapida(a, b, memoria); };
+            medir("minEditDistanceRapida", rapida);
+            medir("con reducción", [&](const std::string& a, const std::string& b) {
+                return minEditDistanceReducida(a, b, rapida, memoria.parteA, memoria.parteB);
+            });
+            std::cout << "Celdas después del recorte: " << 100.0 * celdasCentrales / celdasCompletas << "% de las originales"
+                      << std::endl;
+            return 0;
+        }
+
+        // Políticas de costos fijas contra las tablas globales: ./DP --bench-politicas <largo> <repeticiones>
+        // Para cada política se copian sus costos a las tablas y se compara minEditDistance<CostosTablas>
+        // con minEditDistance<Política> sobre las mismas cadenas (deben dar la misma distancia).
+        if (modo == "--bench-politicas") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-politicas <largo> <repeticiones>");
+            }
+            int largo = std::stoi(argv[2]);
+            int repeticiones = std::stoi(argv[3]);
+            std::string A, B;
+            generarCarga("casi_igual", largo, 1, A, B);
+            double celdas = static_cast<double>(A.size()) * B.size() * repeticiones;
+            auto insertar = cost_insert_table;
+            auto eliminar = cost_delete_table;
+            auto sustituir = cost_matrix;
+            auto transponer = cost_transpose_matrix;
+            MemoriaRapida memoria;
+
+            auto medir = [&](auto motor, int& distancia) {
+                distancia = motor(); // calentamiento
+                auto inicio = std::chrono::steady_clock::now();
+                for (int r = 0; r < repeticiones; ++r) {
+                    distancia = motor();
+                }
+                return celdas / std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            };
+            auto comparar = [&](const std::string& nombre, auto politica) {
+                using Costos = decltype(politica);
+                copiarCostosATablas<Costos>();
+                int generica = 0, especializada = 0;
+                double celdasGenerica = medir([&] { return minEditDistance<CostosTablas>(A, B, memoria); }, generica);
+                double celdasEspecializada = medir([&] { return minEditDistance<Costos>(A, B, memoria); }, especializada);
+                std::cout << nombre << ": distancia " << especializada << (generica == especializada ? "" : " (distinta!)")
+                          << ", tablas " << celdasGenerica << " celdas por segundo, política " << celdasEspecializada
+                          << " (" << celdasEspecializada / celdasGenerica << "x)" << std::endl;
+            };
+            comparar("CostosUnitarios", CostosUnitarios());
+            comparar("CostosTeclado", CostosTeclado());
+            comparar("SinMayusculas<CostosUnitarios>", SinMayusculas<CostosUnitarios>());
+            cost_insert_table = insertar;
+            cost_delete_table = eliminar;
+            cost_matrix = sustituir;
+            cost_transpose_matrix = transponer;
+            return 0;
+        }
+
+        // Escalamiento del DP paralelo: ./DP --bench-paralelo <largo> <hilos_max> <tam_bloque>
+        // Compara contra minEditDistance (una sola hebra) con 1..hilos_max hebras.
+        if (modo == "--bench-paralelo") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --bench-paralelo <largo> <hilos_max> <tam_bloque>");
+            }
+            int largo = std::stoi(argv[2]);
+            int hilosMax = std::stoi(argv[3]);
+            int tamBloque = std::stoi(argv[4]);
+            std::string A = generarCadenaAleatoria(largo, 1);
+            std::string B = generarCadenaAleatoria(largo, 2);
+
+            auto inicio = std::chrono::high_resolution_clock::now();
+            int esperado = minEditDistance(A, B);
+            auto fin = std::chrono::high_resolution_clock::now();
+            double serial = std::chrono::duration<double>(fin - inicio).count();
+            std::cout << "minEditDistance: distancia " << esperado << ", " << serial << " s" << std::endl;
+
+            std::cout << "hilos,segundos,aceleracion,eficiencia,distancia" << std::endl;
+            for (int hilos = 1; hilos <= hilosMax; ++hilos) {
+                inicio = std::chrono::high_resolution_clock::now();
+                int result = minEditDistanceParalelo(A, B, hilos, tamBloque);
+                fin = std::chrono::high_resolution_clock::now();
+                double segundos = std::chrono::duration<double>(fin - inicio).count();
+                std::cout << hilos << "," << segundos << "," << serial / segundos << ","
+                          << serial / segundos / hilos << "," << result << std::endl;
+            }
+            return 0;
+        }
+
+        // Memoria de trabajo reutilizable: ./DP --bench-espacio <largo> <pares>
+        // Muchos pares cortos: compara minEditDistance (tabla completa), minEditDistanceRapida con
+        // memoria nueva en cada llamada y con una MemoriaRapida reutilizada. Los pedidos de memoria
+        // por llamada solo se cuentan si se compiló con -DDP_METRICAS.
+        if (modo == "--bench-espacio") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-espacio <largo> <pares>");
+            }
+            int largo = std::stoi(argv[2]);
+            int cantidad = std::stoi(argv[3]);
+            std::vector<std::pair<std::string, std::string>> pares;
+            for (int p = 0; p < cantidad; ++p) {
+                std::string A, B;
+                generarCarga(p % 2 == 0 ? "aleatoria" : "casi_igual", largo, p + 1, A, B);
+                pares.emplace_back(A, B);
+            }
+
+            MemoriaRapida memoria;
+            auto medir = [&](const std::string& nombre, auto funcion) {
+#ifdef DP_METRICAS
+                unsigned long long reservasAntes = metricas.reservas;
+#endif
+                long long suma = 0;
+                auto inicio = std::chrono::steady_clock::now();
+                for (const auto& par : pares) {
+                    suma += funcion(par.first, par.second);
+                }
+                double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                std::cout << nombre << ": " << cantidad / std::max(segundos, 1e-9) << " pares por segundo";
+#ifdef DP_METRICAS
+                std::cout << ", " << static_cast<double>(metricas.reservas - reservasAntes) / cantidad
+                          << " pedidos de memoria por llamada";
+#endif
+                std::cout << " (suma " << suma << ")" << std::endl;
+            };
+            medir("minEditDistance", [](const std::string& A, const std::string& B) {
+                return minEditDistance(A, B);
+            });
+            medir("minEditDistanceRapida (memoria nueva)", [](const std::string& A, const std::string& B) {
+                return minEditDistanceRapida(A, B);
+            });
+            medir("minEditDistanceRapida (memoria reutilizada)", [&](const std::string& A, const std::string& B) {
+                return minEditDistanceRapida(A, B, memoria);
+            });
+            medir("minEditDistanceAuto (memoria reutilizada)", [&](const std::string& A, const std::string& B) {
+                return minEditDistanceAuto(A, B, memoria);
+            });
+            std::cout << "La memoria reutilizada creció " << memoria.crecimientos << " veces hasta "
+                      << memoria.capacidad() << " bytes" << std::endl;
+            return 0;
+        }
+
+        // Distancia acotada: ./DP --bench-acotada <largo> <k>
+        // B es A con una letra cambiada cada 100 posiciones (pares parecidos, el caso común)
+        if (modo == "--bench-acotada") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-acotada <largo> <k>");
+            }
+            int k = std::stoi(argv[3]);
+            std::string A = generarCadenaAleatoria(std::stoi(argv[2]), 1);
+            std::string B = A;
+            for (size_t p = 0; p < B.size(); p += 100) {
+                B[p] = static_cast<char>('a' + (B[p] - 'a' + 1) % ALPHABET_SIZE);
+            }
+
+            auto inicio = std::chrono::high_resolution_clock::now();
+            int completa = minEditDistanceRapida(A, B);
+            auto medio = std::chrono::high_resolution_clock::now();
+            int acotada = minEditDistanceBounded(A, B, k);
+            auto fin = std::chrono::high_resolution_clock::now();
+
+            std::cout << "minEditDistanceRapida: " << completa << " en "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(medio - inicio).count() << " microsegundos" << std::endl;
+            std::cout << "minEditDistanceBounded (k = " << k << "): "
+                      << (acotada == MAYOR_QUE_K ? std::string("> k") : std::to_string(acotada)) << " en "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(fin - medio).count() << " microsegundos" << std::endl;
+            return 0;
+        }
+
+        // Búsqueda en diccionario: ./DP --diccionario <palabras.txt> <k> [limite]
+        // Lee una consulta por línea desde stdin y muestra las k palabras más cercanas.
+        // Con --bench-diccionario se compara además contra calcular la distancia palabra por palabra.
+        if (modo == "--diccionario" || modo == "--bench-diccionario") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: " + modo + " <palabras.txt> <k> [limite]");
+            }
+            std::ifstream archivo(argv[2]);
+            if (!archivo.is_open()) {
+                throw std::runtime_error("Error al abrir el archivo: " + std::string(argv[2]));
+            }
+            int k = std::stoi(argv[3]);
+            int limite = argc > 4 ? std::stoi(argv[4]) : INT_MAX;
+            DiccionarioTrie diccionario;
+            std::vector<std::string> lista;
+            std::string palabra;
+            while (archivo >> palabra) {
+                if (diccionario.agregar(palabra) && modo == "--bench-diccionario") {
+                    lista.push_back(palabra);
+                }
+            }
+            std::cout << "Diccionario con " << diccionario.cantidadPalabras() << " palabras." << std::endl;
+
+            std::string consulta;
+            while (std::getline(std::cin, consulta)) {
+                if (consulta.empty()) {
+                    continue;
+                }
+                auto inicio = std::chrono::steady_clock::now();
+                std::vector<std::pair<int, std::string>> cercanas = diccionario.buscar(consulta, k, limite);
+                auto fin = std::chrono::steady_clock::now();
+                std::cout << consulta << ":";
+                for (const auto& par : cercanas) {
+                    std::cout << " " << par.second << " (" << par.first << ")";
+                }
+                std::cout << "  [" << std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()
+                          << " microsegundos]" << std::endl;
+
+                if (modo == "--bench-diccionario") {
+                    // Palabra por palabra, para comparar tiempo y distancias
+                    MemoriaRapida memoria;
+                    std::vector<int> distancias;
+                    inicio = std::chrono::steady_clock::now();
+                    for (const std::string& p : lista) {
+                        distancias.push_back(minEditDistanceRapida(consulta, p, memoria));
+                    }
+                    fin = std::chrono::steady_clock::now();
+                    std::sort(distancias.begin(), distancias.end());
+                    bool coincide = true;
+                    for (size_t r = 0; r < cercanas.size(); ++r) {
+                        coincide = coincide && distancias[r] == cercanas[r].first;
+                    }
+                    std::cout << "  palabra por palabra: "
+                              << std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()
+                              << " microsegundos, distancias " << (coincide ? "iguales" : "DISTINTAS") << std::endl;
+                }
+            }
+            return 0;
+        }
+
+        // Sesión incremental: ./DP --sesion <A>
+        // Cada línea de stdin agrega sus letras a B, una por una; una línea con "-" quita la última.
+        // Después de cada cambio se muestra B y la distancia actual.
+        if (modo == "--sesion") {
+            if (argc < 3) {
+                throw std::invalid_argument("Uso: --sesion <A>");
+            }
+            SesionIncremental sesion(argv[2]);
+            std::string linea;
+            while (std::getline(std::cin, linea)) {
+                if (linea == "-") {
+                    sesion.quitar();
+                    std::cout << "\"" << sesion.cadenaB() << "\": " << sesion.distancia() << std::endl;
+                    continue;
+                }
+                for (char c : linea) {
+                    sesion.agregar(c);
+                    std::cout << "\"" << sesion.cadenaB() << "\": " << sesion.distancia() << std::endl;
+                }
+            }
+            return 0;
+        }
+
+        // Latencia por tecla: ./DP --bench-incremental <largoA> <largoB> [semilla]
+        // Escribe B de a una letra, con un retroceso cada 7 teclas, y compara la sesión incremental
+        // contra recalcular minEditDistanceRapida completo en cada tecla.
+        if (modo == "--bench-incremental") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-incremental <largoA> <largoB> [semilla]");
+            }
+            unsigned semilla = argc > 4 ? std::stoul(argv[4]) : 1;
+            std::string A = generarCadenaAleatoria(std::stoi(argv[2]), semilla);
+            std::string B = generarCadenaAleatoria(std::stoi(argv[3]), semilla + 1);
+
+            SesionIncremental sesion(A);
+            MemoriaRapida memoria;
+            std::vector<double> incremental, completa;
+            int distintas = 0;
+            int teclas = 0;
+            for (char c : B) {
+                bool retroceso = ++teclas % 7 == 0 && !sesion.cadenaB().empty();
+                auto inicio = std::chrono::steady_clock::now();
+                if (retroceso) {
+                    sesion.quitar();
+                } else {
+                    sesion.agregar(c);
+                }
+                int distancia = sesion.distancia();
+                auto medio = std::chrono::steady_clock::now();
+                int esperada = minEditDistanceRapida(A, sesion.cadenaB(), memoria);
+                auto fin = std::chrono::steady_clock::now();
+                incremental.push_back(std::chrono::duration<double, std::micro>(medio - inicio).count());
+                completa.push_back(std::chrono::duration<double, std::micro>(fin - medio).count());
+                distintas += distancia != esperada;
+            }
+
+            auto percentil = [](std::vector<double> tiempos, double p) {
+                std::sort(tiempos.begin(), tiempos.end());
+                return tiempos.empty() ? 0.0 : tiempos[static_cast<size_t>(p * (tiempos.size() - 1))];
+            };
+            std::cout << teclas << " teclas, " << distintas << " distancias distintas, "
+                      << sesion.recalculos << " recálculos por retroceso" << std::endl;
+            std::cout << "Sesión incremental: mediana " << percentil(incremental, 0.5) << " us, p99 "
+                      << percentil(incremental, 0.99) << " us por tecla" << std::endl;
+            std::cout << "Recalcular completo: mediana " << percentil(completa, 0.5) << " us, p99 "
+                      << percentil(completa, 0.99) << " us por tecla" << std::endl;
+            return 0;
+        }
+
+        // Búsqueda aproximada en un archivo: ./DP --buscar <archivo> <patron> <k> [bloqueMB]
+        // Muestra una línea "posición costo" por cada final de coincidencia (posición en bytes del
+        // último carácter) y al final, por stderr, la cantidad de coincidencias y los MB/s.
+        if (modo == "--buscar") {
+            if (argc < 5) {
+                throw std::invalid_argument("Uso: --buscar <archivo> <patron> <k> [bloqueMB]");
+            }
+            size_t bloque = (argc > 5 ? std::stoul(argv[5]) : 64) << 20;
+            BusquedaAproximada busqueda(argv[3], std::stoi(argv[4]));
+            long long coincidencias = 0;
+            auto inicio = std::chrono::steady_clock::now();
+            uint64_t bytes = buscarEnArchivo(argv[2], busqueda, bloque, [&](uint64_t posicion, int costo) {
+                ++coincidencias;
+                std::cout << posicion << ' ' << costo << '\n';
+            });
+            std::cout.flush();
+            double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            std::cerr << coincidencias << " coincidencias en " << bytes << " bytes, "
+                      << bytes / 1048576.0 / std::max(segundos, 1e-9) << " MB/s" << std::endl;
+            return 0;
+        }
+
+        // Filtro de candidatos: ./DP --filtro <candidatos.txt> <k>
+        // Lee una consulta por línea desde stdin y cuenta los candidatos a distancia <= k, con y sin
+        // el filtro de cotas inferiores, mostrando la tasa de descarte y la aceleración.
+        if (modo == "--filtro") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --filtro <candidatos.txt> <k>");
+            }
+            std::ifstream archivo(argv[2]);
+            if (!archivo.is_open()) {
+                throw std::runtime_error("Error al abrir el archivo: " + std::string(argv[2]));
+            }
+            int k = std::stoi(argv[3]);
+            std::vector<std::string> candidatos;
+            std::string palabra;
+            while (archivo >> palabra) {
+                candidatos.push_back(palabra);
+            }
+
+            FiltroCandidatos filtro;
+            MemoriaRapida memoria;
+            std::string consulta;
+            while (std::getline(std::cin, consulta)) {
+                if (consulta.empty()) {
+                    continue;
+                }
+                filtro.fijarConsulta(consulta);
+                long long antesLargo = filtro.descartadosPorLargo, antesHistograma = filtro.descartadosPorHistograma;
+                int conFiltro = 0, sinFiltro = 0;
+
+                auto inicio = std::chrono::steady_clock::now();
+                for (const std::string& candidato : candidatos) {
+                    conFiltro += filtro.distanciaAcotada(candidato, k) != MAYOR_QUE_K;
+                }
+                auto medio = std::chrono::steady_clock::now();
+                for (const std::string& candidato : candidatos) {
+                    sinFiltro += minEditDistanceRapida(consulta, candidato, memoria) <= k;
+                }
+                auto fin = std::chrono::steady_clock::now();
+
+                double usFiltro = std::chrono::duration<double, std::micro>(medio - inicio).count();
+                double usCompleto = std::chrono::duration<double, std::micro>(fin - medio).count();
+                long long descartados = (filtro.descartadosPorLargo - antesLargo) + (filtro.descartadosPorHistograma - antesHistograma);
+                std::cout << consulta << ": " << conFiltro << " candidatos a distancia <= " << k
+                          << (conFiltro == sinFiltro ? "" : " (DISTINTO sin filtro)") << ", descartados "
+                          << 100.0 * descartados / std::max<size_t>(1, candidatos.size()) << "% (largo "
+                          << filtro.descartadosPorLargo - antesLargo << ", histograma "
+                          << filtro.descartadosPorHistograma - antesHistograma << "), "
+                          << usFiltro << " vs " << usCompleto << " microsegundos (aceleración "
+                          << usCompleto / std::max(1.0, usFiltro) << "x)" << std::endl;
+            }
+            return 0;
+        }
+
+        // Matriz de todos contra todos: ./DP --todos-contra-todos <cadenas.txt> <salida.bin> [hilos] [filaInicio filaFin] [bloque]
+        // Una cadena por línea. Con filaInicio y filaFin se calcula solo ese fragmento de filas (para
+        // repartirlo entre procesos); los fragmentos se juntan con --unir-matriz.
+        if (modo == "--todos-contra-todos") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --todos-contra-todos <cadenas.txt> <salida.bin> [hilos] [filaInicio filaFin] [bloque]");
+            }
+            std::ifstream archivo(argv[2]);
+            if (!archivo.is_open()) {
+                throw std::runtime_error("Error al abrir el archivo: " + std::string(argv[2]));
+            }
+            std::vector<std::string> cadenas;
+            std::string linea;
+            while (std::getline(archivo, linea)) {
+                if (!linea.empty() && linea.back() == '\r') {
+                    linea.pop_back();
+                }
+                cadenas.push_back(linea);
+            }
+            int hilos = argc > 4 ? std::stoi(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+            uint64_t filaInicio = argc > 6 ? std::stoull(argv[5]) : 0;
+            uint64_t filaFin = argc > 6 ? std::stoull(argv[6]) : cadenas.size();
+            int bloque = argc > 7 ? std::stoi(argv[7]) : 64;
+            calcularMatriz(cadenas, argv[3], filaInicio, filaFin, hilos, bloque);
+            return 0;
+        }
+
+        // Modo por lotes: ./DP --lote <entrada|-> <salida|-> <hilos> [--guion]
+        // Cada línea de la entrada es un par "A B"; la salida tiene una distancia por línea (con
+        // --guion, seguida de las operaciones).
+        if (modo == "--lote") {
+            if (argc < 5 || (argc > 5 && std::string(argv[5]) != "--guion")) {
+                throw std::invalid_argument("Uso: --lote <entrada|-> <salida|-> <hilos> [--guion]");
+            }
+            std::string rutaEntrada = argv[2];
+            std::string rutaSalida = argv[3];
+            std::ifstream archivoEntrada;
+            std::ofstream archivoSalida;
+            if (rutaEntrada != "-") {
+                archivoEntrada.open(rutaEntrada);
+                if (!archivoEntrada.is_open()) {
+                    throw std::runtime_error("Error al abrir el archivo: " + rutaEntrada);
+                }
+            }
+            if (rutaSalida != "-") {
+                archivoSalida.open(rutaSalida);
+                if (!archivoSalida.is_open()) {
+                    throw std::runtime_error("Error al abrir el archivo: " + rutaSalida);
+                }
+            }
+            procesarLote(rutaEntrada == "-" ? std::cin : archivoEntrada,
+                         rutaSalida == "-" ? std::cout : archivoSalida, std::stoi(argv[4]), 256, argc > 5);
+            return 0;
+        }
+
+        // Servidor de distancias: ./DP --servidor <socket|-> [hilos] [en vuelo por conexión]
+        if (modo == "--servidor") {
+            if (argc < 3) {
+                throw std::invalid_argument("Uso: --servidor <socket|-> [hilos] [en vuelo por conexión]");
+            }
+            std::signal(SIGPIPE, SIG_IGN); // un cliente que se va no debe terminar el servidor
+            int hilos = argc > 3 ? std::stoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+            ServidorDistancias servidor(hilos, argc > 4 ? std::stoi(argv[4]) : 256);
+            if (std::string(argv[2]) == "-") {
+                servidor.atender(STDIN_FILENO, STDOUT_FILENO);
+            } else {
+                servidor.escuchar(argv[2]);
+            }
+            return 0;
+        }
 
         // Cadenas de prueba, ACA CAMBIAR PARA LOS CASOS DE PRUEBA
         std::string A = "ababababab";
@@ -200,8 +4713,10 @@ int main() {
         // Medir tiempo de ejecución
         auto inicio = std::chrono::high_resolution_clock::now();
 
-        // Calcular y mostrar la distancia mínima de edición
-        int result = minEditDistance(A, B);
+        // Calcular y mostrar la distancia mínima de edición (con la etapa de reducción delante)
+        int result = minEditDistanceReducida(A, B, [](const std::string& a, const std::string& b) {
+            return minEditDistance(a, b);
+        });
         std::cout << "Distancia mínima de edición: " << result << std::endl;
 
         auto fin = std::chrono::high_resolution_clock::now();
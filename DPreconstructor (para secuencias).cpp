@@ -8,14 +8,92 @@
 #include <climits>
 #include <cctype>
 #include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <chrono>
 #include <utility>
+#include <cstdint>
+#include <random>
+#include <sys/resource.h>
 
 const int ALPHABET_SIZE = 26;
-std::array<int, ALPHABET_SIZE> cost_delete_table;
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix;
-std::array<int, ALPHABET_SIZE> cost_insert_table;
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix;
+alignas(64) std::array<int, ALPHABET_SIZE> cost_delete_table;
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix;
+alignas(64) std::array<int, ALPHABET_SIZE> cost_insert_table;
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix;
+
+// Métricas opcionales: compilar con -DDP_METRICAS. Sin esa bandera las macros no generan código.
+// Con ella se cuentan las celdas del DP, las consultas a las funciones de costo y los pedidos de
+// memoria dinámica, se mide cada fase
+// (carga de costos, reserva de memoria, llenado y reconstrucción siguiendo los punteros) y los bytes
+// pedidos para las filas del DP y para la tabla de operaciones (punteros), y al terminar se
+// escribe todo como JSON en stderr o en el archivo indicado por METRICAS_JSON.
+#ifdef DP_METRICAS
+struct Metricas {
+    unsigned long long celdas = 0;
+    unsigned long long consultasCosto = 0;
+    unsigned long long bytesDp = 0;
+    unsigned long long bytesOperacion = 0;
+    unsigned long long cargaNs = 0;
+    unsigned long long reservaNs = 0;
+    unsigned long long llenadoNs = 0;
+    unsigned long long reconstruccionNs = 0;
+    unsigned long long reservas = 0; // llamadas a operator new
+};
+Metricas metricas;
+
+// Contar cada pedido de memoria dinámica del programa. Sin inline: si GCC ve el malloc de adentro
+// junto al delete del llamador, avisa de un par mal combinado.
+__attribute__((noinline)) void* operator new(size_t bytes) {
+    ++metricas.reservas;
+    if (void* memoria = std::malloc(bytes ? bytes : 1)) {
+        return memoria;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memoria) noexcept {
+    std::free(memoria);
+}
+
+__attribute__((noinline)) void operator delete(void* memoria, size_t) noexcept {
+    std::free(memoria);
+}
+
+#define METRICA_SUMAR(campo, valor) (metricas.campo += (valor))
+#define METRICA_INICIO(nombre) auto nombre = std::chrono::steady_clock::now()
+#define METRICA_FIN(nombre, campo) \
+    METRICA_SUMAR(campo, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - nombre).count())
+
+// Escribir las métricas como JSON (se registra con atexit al comenzar main)
+void exportarMetricas() {
+    std::ofstream archivo;
+    const char* ruta = std::getenv("METRICAS_JSON");
+    if (ruta != nullptr) {
+        archivo.open(ruta);
+    }
+    std::ostream& salida = archivo.is_open() ? static_cast<std::ostream&>(archivo) : std::cerr;
+    salida << "{\"programa\": \"DPreconstructor\", \"celdas\": " << metricas.celdas
+           << ", \"consultas_costo\": " << metricas.consultasCosto
+           << ", \"bytes_dp\": " << metricas.bytesDp
+           << ", \"bytes_operacion\": " << metricas.bytesOperacion
+           << ", \"reservas_memoria\": " << metricas.reservas
+           << ", \"fases_us\": {\"carga\": " << metricas.cargaNs / 1000.0
+           << ", \"reserva\": " << metricas.reservaNs / 1000.0
+           << ", \"llenado\": " << metricas.llenadoNs / 1000.0
+           << ", \"reconstruccion\": " << metricas.reconstruccionNs / 1000.0 << "}}" << std::endl;
+}
+#else
+#define METRICA_SUMAR(campo, valor) ((void)0)
+#define METRICA_INICIO(nombre) ((void)0)
+#define METRICA_FIN(nombre, campo) ((void)0)
+#endif
 
 
 
@@ -96,6 +174,181 @@ void cargar_matriz_costos(const std::string& filename) {
     file.close();
 }
 
+// Perfiles de costos binarios
+// Un archivo de perfiles guarda varias combinaciones de las cuatro tablas, ya validadas, para
+// cargarlas sin volver a leer texto. Formato (enteros en el orden de bytes de la máquina):
+//   EncabezadoPerfiles (64 bytes): "COSTOS01", versión, cantidad de perfiles y tamaño del alfabeto
+//   PerfilBinario por cada perfil: nombre, suma de verificación y las cuatro tablas, alineado a 64
+// El archivo se mapea en memoria (mmap) y se copia el perfil elegido a las tablas globales.
+const char MAGIA_PERFILES[8] = {'C', 'O', 'S', 'T', 'O', 'S', '0', '1'};
+const uint32_t VERSION_PERFILES = 1;
+
+struct alignas(64) EncabezadoPerfiles {
+    char magia[8];
+    uint32_t version;
+    uint32_t cantidad;
+    uint32_t alfabeto;
+};
+
+struct alignas(64) PerfilBinario {
+    char nombre[32];
+    uint64_t suma;      // FNV-1a de 64 bits sobre las cuatro tablas
+    char relleno[24];   // para que las tablas partan alineadas a 64 bytes
+    int32_t insertar[ALPHABET_SIZE];
+    int32_t eliminar[ALPHABET_SIZE];
+    int32_t sustituir[ALPHABET_SIZE][ALPHABET_SIZE];
+    int32_t transponer[ALPHABET_SIZE][ALPHABET_SIZE];
+};
+
+static_assert(sizeof(EncabezadoPerfiles) == 64, "El encabezado debe ocupar 64 bytes");
+static_assert(sizeof(PerfilBinario) % 64 == 0, "Cada perfil debe quedar alineado a 64 bytes");
+
+// Suma de verificación de las tablas de un perfil
+uint64_t sumaPerfil(const PerfilBinario& perfil) {
+    const unsigned char* inicio = reinterpret_cast<const unsigned char*>(perfil.insertar);
+    const unsigned char* fin = reinterpret_cast<const unsigned char*>(perfil.transponer + ALPHABET_SIZE);
+    uint64_t suma = 1469598103934665603ULL;
+    for (const unsigned char* p = inicio; p != fin; ++p) {
+        suma = (suma ^ *p) * 1099511628211ULL;
+    }
+    return suma;
+}
+
+// Archivo de perfiles mapeado en memoria; se mantiene abierto para poder cambiar de perfil
+class ArchivoPerfiles {
+public:
+    explicit ArchivoPerfiles(const std::string& ruta) {
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error al abrir el archivo de perfiles: " + ruta);
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(EncabezadoPerfiles))) {
+            close(descriptor);
+            throw std::runtime_error("Archivo de perfiles incompleto: " + ruta);
+        }
+        tamano = info.st_size;
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("No se pudo mapear el archivo de perfiles: " + ruta);
+        }
+        datos = static_cast<const unsigned char*>(mapa);
+
+        const EncabezadoPerfiles* encabezado = reinterpret_cast<const EncabezadoPerfiles*>(datos);
+        if (std::memcmp(encabezado->magia, MAGIA_PERFILES, sizeof(MAGIA_PERFILES)) != 0 ||
+            encabezado->version != VERSION_PERFILES || encabezado->alfabeto != ALPHABET_SIZE ||
+            tamano != sizeof(EncabezadoPerfiles) + encabezado->cantidad * sizeof(PerfilBinario)) {
+            munmap(const_cast<unsigned char*>(datos), tamano);
+            throw std::runtime_error("El archivo '" + ruta + "' no es un archivo de perfiles válido");
+        }
+        cantidad = encabezado->cantidad;
+        perfiles = reinterpret_cast<const PerfilBinario*>(datos + sizeof(EncabezadoPerfiles));
+    }
+
+    ~ArchivoPerfiles() {
+        munmap(const_cast<unsigned char*>(datos), tamano);
+    }
+
+    ArchivoPerfiles(const ArchivoPerfiles&) = delete;
+    ArchivoPerfiles& operator=(const ArchivoPerfiles&) = delete;
+
+    // Buscar un perfil por nombre y verificar su suma
+    const PerfilBinario& buscar(const std::string& nombre) const {
+        for (uint32_t k = 0; k < cantidad; ++k) {
+            if (nombre == std::string(perfiles[k].nombre, strnlen(perfiles[k].nombre, sizeof(perfiles[k].nombre)))) {
+                if (sumaPerfil(perfiles[k]) != perfiles[k].suma) {
+                    throw std::runtime_error("El perfil '" + nombre + "' está corrupto (suma de verificación)");
+                }
+                return perfiles[k];
+            }
+        }
+        throw std::runtime_error("No existe el perfil: " + nombre);
+    }
+
+    // Copiar un perfil a las tablas globales (cambiar de modelo de costos sin leer texto)
+    void usar(const std::string& nombre) const {
+        const PerfilBinario& perfil = buscar(nombre);
+        for (int a = 0; a < ALPHABET_SIZE; ++a) {
+            cost_insert_table[a] = perfil.insertar[a];
+            cost_delete_table[a] = perfil.eliminar[a];
+            for (int b = 0; b < ALPHABET_SIZE; ++b) {
+                cost_matrix[a][b] = perfil.sustituir[a][b];
+                cost_transpose_matrix[a][b] = perfil.transponer[a][b];
+            }
+        }
+    }
+
+    uint32_t cantidad = 0;
+    const PerfilBinario* perfiles = nullptr;
+
+private:
+    const unsigned char* datos = nullptr;
+    size_t tamano = 0;
+};
+
+// Si alguna tabla cargada tiene costos negativos el recorte de prefijo y sufijo deja de valer. En
+// true hasta revisarCostosNegativos().
+bool costos_negativos = true;
+
+// Revisar las cuatro tablas una vez; se llama después de cargarlas
+void revisarCostosNegativos() {
+    bool negativos = false;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        negativos = negativos || cost_insert_table[a] < 0 || cost_delete_table[a] < 0;
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            negativos = negativos || cost_matrix[a][b] < 0 || cost_transpose_matrix[a][b] < 0;
+        }
+    }
+    costos_negativos = negativos;
+}
+
+// Etapa de reducción, la misma de DP.cpp: se quitan el prefijo y el sufijo comunes cuando la letra
+// x que se quita cumple, para toda letra y, ins(y) <= ins(x) + sub(x, y) y del(y) <= del(x) + sub(y, x)
+// (y sustituir una letra por sí misma cuesta 0 en todo el alfabeto); con eso la distancia no cambia.
+std::array<bool, ALPHABET_SIZE> letraRecortable{}; // sin recorte hasta llamar a prepararRecorte()
+
+// Revisar la condición para cada letra (sin recorte si hay costos negativos); se llama después
+// de revisarCostosNegativos()
+void prepararRecorte() {
+    bool identidadGratis = !costos_negativos;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        identidadGratis = identidadGratis && cost_matrix[a][a] == 0;
+    }
+    for (int x = 0; x < ALPHABET_SIZE; ++x) {
+        bool recortable = identidadGratis;
+        for (int y = 0; y < ALPHABET_SIZE && recortable; ++y) {
+            recortable = cost_insert_table[y] <= cost_insert_table[x] + cost_matrix[x][y] &&
+                         cost_delete_table[y] <= cost_delete_table[x] + cost_matrix[y][x];
+        }
+        letraRecortable[x] = recortable;
+    }
+}
+
+struct Recorte {
+    int prefijo = 0;
+    int sufijo = 0;
+};
+
+// Largo del prefijo y del sufijo comunes que se pueden quitar (sin solaparse); compara los
+// caracteres tal cual, como la transposición
+Recorte recortarComunes(const std::string& A, const std::string& B) {
+    auto recortable = [](char c) {
+        unsigned char u = static_cast<unsigned char>(c);
+        return std::isalpha(u) && letraRecortable[std::tolower(u) - 'a'];
+    };
+    Recorte r;
+    int largo = std::min(A.size(), B.size());
+    while (r.prefijo < largo && A[r.prefijo] == B[r.prefijo] && recortable(A[r.prefijo])) {
+        ++r.prefijo;
+    }
+    while (r.sufijo < largo - r.prefijo && A[A.size() - 1 - r.sufijo] == B[B.size() - 1 - r.sufijo] &&
+           recortable(A[A.size() - 1 - r.sufijo])) {
+        ++r.sufijo;
+    }
+    return r;
+}
+
 int costo_sub(char a, char b) {
     int index_a = tolower(a) - 'a';
     int index_b = tolower(b) - 'a';
@@ -105,24 +358,24 @@ int costo_sub(char a, char b) {
         throw std::invalid_argument("Caracteres fuera del rango permitido");
     }
 
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_matrix[index_a][index_b];
 }
 // Función que devuelve el costo de insertar el carácter 'b' en la cadena
 int cost_ins(char b) {
-    if (!std::isalpha(b)) {
-        std::cerr << "El carácter '" << b << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument(std::string("El carácter '") + b + "' no es una letra válida.");
     }
 
     b = std::tolower(b); // Convertir a minúscula si es necesario
     int index = b - 'a'; // Calcular el índice correspondiente
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_insert_table[index];
 }
 // Función que devuelve el costo de intercambiar dos caracteres adyacentes
 int cost_trans(char a, char b) {
-    if (!std::isalpha(a) || !std::isalpha(b)) {
-        std::cerr << "Uno o ambos caracteres no son letras válidas." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a)) || !std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument("Uno o ambos caracteres no son letras válidas.");
     }
 
     a = std::tolower(a); // Convertir a minúscula si es necesario
@@ -130,124 +383,686 @@ int cost_trans(char a, char b) {
     int index_a = a - 'a';
     int index_b = b - 'a';
 
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_transpose_matrix[index_a][index_b];
 }
 int cost_del(char a) {
-    if (!std::isalpha(a)) {
-        std::cerr << "El carácter '" << a << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a))) {
+        throw std::invalid_argument(std::string("El carácter '") + a + "' no es una letra válida.");
     }
 
     a = std::tolower(a); // Convertir a minúscula si es necesario
     int index = a - 'a'; // Calcular el índice correspondiente
+    METRICA_SUMAR(consultasCosto, 1);
     return cost_delete_table[index];
 }
 
+// Convertir una cadena a índices del alfabeto (0..25), validando cada carácter una sola vez
+// (versión que escribe en un arreglo ya reservado de cadena.size() enteros)
+void codificarCadena(const std::string& cadena, int* codigos) {
+    for (size_t k = 0; k < cadena.size(); ++k) {
+        unsigned char c = static_cast<unsigned char>(cadena[k]);
+        if (!std::isalpha(c)) {
+            throw std::invalid_argument("El carácter '" + std::string(1, cadena[k]) + "' no es una letra válida.");
+        }
+        codigos[k] = std::tolower(c) - 'a';
+    }
+}
 
-int minEditDistance(const std::string& A, const std::string& B, std::vector<std::string>& operaciones) {
-    int m = A.size();
-    int n = B.size();
+std::vector<int> codificarCadena(const std::string& cadena) {
+    std::vector<int> codigos(cadena.size());
+    codificarCadena(cadena, codigos.data());
+    return codigos;
+}
 
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1, INT_MAX));
-    std::vector<std::vector<std::string>> operacion(m + 1, std::vector<std::string>(n + 1, ""));
+// Tipos de operación de edición. También son los códigos de 2 bits de la tabla de punteros.
+enum TipoOperacion : uint8_t { INSERTAR = 0, ELIMINAR = 1, SUSTITUIR = 2, TRANSPONER = 3 };
 
-    // Inicialización de la primera fila y columna
-    dp[0][0] = 0;
-    for (int i = 1; i <= m; ++i) {
-        dp[i][0] = dp[i - 1][0] + cost_del(A[i - 1]);
-        operacion[i][0] = "Eliminar " + std::string(1, A[i - 1]);
+// Operación de edición en forma compacta; el texto en español se arma solo al imprimir
+struct EditOp {
+    TipoOperacion tipo;
+    int posA; // posición en A (al transponer, la primera de las dos letras)
+    int posB; // posición en B
+};
+
+// Memoria de trabajo de la reconstrucción, reutilizable entre llamadas: un solo buffer contiguo
+// que solo crece. Cada llamada pide con preparar() el total que va a usar y luego lo reparte con
+// tomar(); solo se pide memoria al sistema cuando el total supera lo que ya se tiene.
+class MemoriaReconstruccion {
+public:
+    // Bytes que ocupa un arreglo de 'cantidad' elementos dentro del buffer (múltiplo de 8)
+    template <typename T>
+    static size_t bytesPara(size_t cantidad) {
+        return (cantidad * sizeof(T) + 7) / 8 * 8;
     }
+
+    // Dejar al menos 'bytes' disponibles y volver al comienzo del buffer. Los arreglos entregados
+    // antes dejan de ser válidos.
+    void preparar(size_t bytes) {
+        size_t palabras = (bytes + 7) / 8;
+        if (palabras > capacidadPalabras) {
+            buffer.reset(new uint64_t[palabras]);
+            capacidadPalabras = palabras;
+            ++crecimientos;
+        }
+        usado = 0;
+    }
+
+    // Tomar un arreglo de 'cantidad' elementos (sin inicializar) de lo preparado
+    template <typename T>
+    T* tomar(size_t cantidad) {
+        T* arreglo = reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(buffer.get()) + usado);
+        usado += bytesPara<T>(cantidad);
+        if (usado > capacidadPalabras * 8) {
+            throw std::logic_error("MemoriaReconstruccion: se tomó más de lo preparado");
+        }
+        return arreglo;
+    }
+
+    size_t capacidad() const {
+        return capacidadPalabras * 8;
+    }
+
+    long long crecimientos = 0; // veces que se pidió memoria al sistema
+    std::vector<int> codigos;   // A y B codificadas; van aparte porque el buffer se reparte en cada tabla
+
+private:
+    std::unique_ptr<uint64_t[]> buffer;
+    size_t capacidadPalabras = 0;
+    size_t usado = 0;
+};
+
+// Tabla de punteros hacia atrás con 2 bits por celda (4 celdas por byte): guarda qué operación
+// dio el mínimo en cada celda, en vez de un std::string por celda. Los bytes vienen de una
+// MemoriaReconstruccion (bytesNecesarios dice cuántos) y se limpian al construir la tabla.
+struct TablaPunteros {
+    int columnas;
+    uint8_t* bytes;
+
+    static size_t bytesNecesarios(int filas, int columnas_) {
+        return (static_cast<size_t>(filas) * columnas_ + 3) / 4;
+    }
+
+    TablaPunteros(int filas, int columnas_, uint8_t* memoria) : columnas(columnas_), bytes(memoria) {
+        std::memset(bytes, 0, bytesNecesarios(filas, columnas_));
+    }
+
+    // Cada celda se escribe una sola vez y los bytes parten en 0, así que basta con un OR
+    void poner(int i, int j, TipoOperacion tipo) {
+        size_t k = static_cast<size_t>(i) * columnas + j;
+        bytes[k >> 2] |= static_cast<uint8_t>(tipo << ((k & 3) * 2));
+    }
+
+    TipoOperacion obtener(int i, int j) const {
+        size_t k = static_cast<size_t>(i) * columnas + j;
+        return static_cast<TipoOperacion>((bytes[k >> 2] >> ((k & 3) * 2)) & 3);
+    }
+};
+
+// Texto de una operación, con el mismo formato que se imprimía antes
+std::string describirOperacion(const EditOp& op, const std::string& A, const std::string& B) {
+    switch (op.tipo) {
+        case INSERTAR:
+            return "Insertar '" + std::string(1, B[op.posB]) + "' en posición " + std::to_string(op.posB);
+        case ELIMINAR:
+            return "Eliminar '" + std::string(1, A[op.posA]) + "' en posición " + std::to_string(op.posA);
+        case SUSTITUIR:
+            return "Sustituir '" + std::string(1, A[op.posA]) + "' por '" + std::string(1, B[op.posB]) + "' en posición " + std::to_string(op.posA);
+        case TRANSPONER:
+            return "Transponer '" + std::string(1, A[op.posA]) + "' y '" + std::string(1, A[op.posA + 1]) + "' en posiciones " + std::to_string(op.posA) + " y " + std::to_string(op.posA + 1);
+    }
+    return "";
+}
+
+// Llenar el DP sobre las subcadenas A[a0, a1) y B[b0, b1) guardando solo tres filas de costos y la
+// tabla de punteros, y luego seguir los punteros desde (m, n) para agregar las operaciones en
+// orden. Las posiciones de las operaciones son las de las cadenas originales.
+int reconstruirConPunteros(const std::string& A, const std::string& B, const int* codA, const int* codB,
+                           int a0, int a1, int b0, int b1, std::vector<EditOp>& operaciones,
+                           MemoriaReconstruccion& memoria) {
+    int m = a1 - a0;
+    int n = b1 - b0;
+    METRICA_INICIO(inicioReserva);
+    size_t bytesPunteros = TablaPunteros::bytesNecesarios(m + 1, n + 1);
+    memoria.preparar(MemoriaReconstruccion::bytesPara<uint8_t>(bytesPunteros) +
+                     MemoriaReconstruccion::bytesPara<int>(3 * (n + 1)));
+    TablaPunteros punteros(m + 1, n + 1, memoria.tomar<uint8_t>(bytesPunteros));
+    int* filas = memoria.tomar<int>(3 * (n + 1));
+    int* previa2 = filas;
+    int* previa = filas + (n + 1);
+    int* actual = filas + 2 * (n + 1);
+    METRICA_FIN(inicioReserva, reservaNs);
+    METRICA_SUMAR(bytesOperacion, bytesPunteros);
+    METRICA_SUMAR(bytesDp, 3ULL * (n + 1) * sizeof(int));
+    METRICA_INICIO(inicioLlenado);
+
+    // Inicialización de la primera fila y columna
+    previa[0] = 0;
     for (int j = 1; j <= n; ++j) {
-        dp[0][j] = dp[0][j - 1] + cost_ins(B[j - 1]);
-        operacion[0][j] = "Insertar " + std::string(1, B[j - 1]);
+        previa[j] = previa[j - 1] + cost_insert_table[codB[b0 + j - 1]];
+        punteros.poner(0, j, INSERTAR);
     }
 
-    // Llenado de la matriz dp y operacion
+    // Llenado: en cada celda gana la primera opción con costo mínimo, en el orden inserción,
+    // eliminación, sustitución y transposición
     for (int i = 1; i <= m; ++i) {
+        const char a = A[a0 + i - 1];
+        const int* filaSub = cost_matrix[codA[a0 + i - 1]].data();
+        const int borrar = cost_delete_table[codA[a0 + i - 1]];
+        actual[0] = previa[0] + borrar;
+        punteros.poner(i, 0, ELIMINAR);
         for (int j = 1; j <= n; ++j) {
-            // Costo de inserción
-            int cost_insert = dp[i][j - 1] + cost_ins(B[j - 1]);
-            if (cost_insert < dp[i][j]) {
-                dp[i][j] = cost_insert;
-                operacion[i][j] = "Insertar " + std::string(1, B[j - 1]);
+            const char b = B[b0 + j - 1];
+            int valor = actual[j - 1] + cost_insert_table[codB[b0 + j - 1]];
+            TipoOperacion tipo = INSERTAR;
+            if (previa[j] + borrar < valor) {
+                valor = previa[j] + borrar;
+                tipo = ELIMINAR;
             }
-
-            // Costo de eliminación
-            int cost_delete = dp[i - 1][j] + cost_del(A[i - 1]);
-            if (cost_delete < dp[i][j]) {
-                dp[i][j] = cost_delete;
-                operacion[i][j] = "Eliminar " + std::string(1, A[i - 1]);
-            }
-
-            // Costo de sustitución
-            int cost_substitute = dp[i - 1][j - 1] + costo_sub(A[i - 1], B[j - 1]);
-            if (cost_substitute < dp[i][j]) {
-                dp[i][j] = cost_substitute;
-                operacion[i][j] = "Sustituir " + std::string(1, A[i - 1]) + " por " + std::string(1, B[j - 1]);
+            if (previa[j - 1] + filaSub[codB[b0 + j - 1]] < valor) {
+                valor = previa[j - 1] + filaSub[codB[b0 + j - 1]];
+                tipo = SUSTITUIR;
             }
-
-            // Costo de transposición
-            if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
-                int cost_transpose = dp[i - 2][j - 2] + cost_trans(A[i - 1], A[i - 2]);
-                if (cost_transpose < dp[i][j]) {
-                    dp[i][j] = cost_transpose;
-                    operacion[i][j] = "Transponer " + std::string(1, A[i - 2]) + std::string(1, A[i - 1]);
+            if (i > 1 && j > 1 && a == B[b0 + j - 2] && A[a0 + i - 2] == b) {
+                int costo = previa2[j - 2] + cost_transpose_matrix[codA[a0 + i - 1]][codA[a0 + i - 2]];
+                if (costo < valor) {
+                    valor = costo;
+                    tipo = TRANSPONER;
                 }
             }
+            actual[j] = valor;
+            punteros.poner(i, j, tipo);
         }
+        int* libre = previa2;
+        previa2 = previa;
+        previa = actual;
+        actual = libre;
     }
+    METRICA_FIN(inicioLlenado, llenadoNs);
+    METRICA_SUMAR(celdas, 1ULL * m * n);
 
-    // Reconstruir las operaciones
+    // Seguir los punteros desde (m, n); las operaciones salen de atrás hacia adelante
+    METRICA_INICIO(inicioReconstruccion);
+    size_t inicio = operaciones.size();
     int i = m, j = n;
     while (i > 0 || j > 0) {
-        if (i > 0 && dp[i][j] == dp[i - 1][j] + cost_del(A[i - 1])) {
-            operaciones.push_back("Eliminar '" + std::string(1, A[i - 1]) + "' en posición " + std::to_string(i - 1));
-            --i;
-        } else if (j > 0 && dp[i][j] == dp[i][j - 1] + cost_ins(B[j - 1])) {
-            operaciones.push_back("Insertar '" + std::string(1, B[j - 1]) + "' en posición " + std::to_string(j - 1));
-            --j;
-        } else if (i > 0 && j > 0 && dp[i][j] == dp[i - 1][j - 1] + costo_sub(A[i - 1], B[j - 1])) {
-            if (A[i - 1] != B[j - 1]) {
-                operaciones.push_back("Sustituir '" + std::string(1, A[i - 1]) + "' por '" + std::string(1, B[j - 1]) + "' en posición " + std::to_string(i - 1));
+        switch (punteros.obtener(i, j)) {
+            case INSERTAR:
+                operaciones.push_back({INSERTAR, a0 + i, b0 + j - 1});
+                --j;
+                break;
+            case ELIMINAR:
+                operaciones.push_back({ELIMINAR, a0 + i - 1, b0 + j});
+                --i;
+                break;
+            case SUSTITUIR:
+                if (A[a0 + i - 1] != B[b0 + j - 1]) {
+                    operaciones.push_back({SUSTITUIR, a0 + i - 1, b0 + j - 1});
+                }
+                --i;
+                --j;
+                break;
+            case TRANSPONER:
+                operaciones.push_back({TRANSPONER, a0 + i - 2, b0 + j - 2});
+                i -= 2;
+                j -= 2;
+                break;
+        }
+    }
+    std::reverse(operaciones.begin() + inicio, operaciones.end());
+    METRICA_FIN(inicioReconstruccion, reconstruccionNs);
+
+    return previa[n];
+}
+
+// Con una MemoriaReconstruccion reutilizada, las llamadas repetidas no piden memoria al sistema
+// (salvo para agregar operaciones al vector de salida, si no tiene capacidad suficiente)
+int minEditDistance(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones,
+                    MemoriaReconstruccion& memoria) {
+    // Validar y codificar una sola vez; el llenado usa las tablas directamente. Los códigos van
+    // en 'codigos', que no se comparte con la memoria de la tabla
+    memoria.codigos.resize(A.size() + B.size());
+    codificarCadena(A, memoria.codigos.data());
+    codificarCadena(B, memoria.codigos.data() + A.size());
+    const int* codA = memoria.codigos.data();
+    const int* codB = memoria.codigos.data() + A.size();
+    // Con el prefijo y el sufijo comunes fuera, la tabla solo cubre la parte central; las
+    // posiciones de las operaciones ya salen relativas a A y B completas (a0 y b0)
+    Recorte r = recortarComunes(A, B);
+    return reconstruirConPunteros(A, B, codA, codB, r.prefijo, A.size() - r.sufijo, r.prefijo, B.size() - r.sufijo,
+                                  operaciones, memoria);
+}
+
+int minEditDistance(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones) {
+    MemoriaReconstruccion memoria;
+    return minEditDistance(A, B, operaciones, memoria);
+}
+
+// Calcular las dos últimas filas del DP hacia adelante para A[a0, a0 + filas) contra B[b0, b1),
+// rotando entre las tres filas de 'filas' (sin pedir memoria ni copiar). Al terminar, 'anterior'
+// apunta a la fila filas - 1 y 'ultima' a la fila filas, ambas dentro de 'filas'.
+void filasHaciaAdelante(const std::string& A, const std::string& B, const std::vector<int>& codA,
+                        const std::vector<int>& codB, int a0, int filas, int b0, int b1,
+                        std::vector<int> (&buffers)[3], const int*& anterior, const int*& ultima) {
+    int n = b1 - b0;
+    METRICA_INICIO(inicioLlenado);
+    METRICA_SUMAR(celdas, 1ULL * filas * n);
+    METRICA_SUMAR(bytesDp, 3ULL * (n + 1) * sizeof(int));
+    int* previa2 = buffers[0].data();
+    int* previa = buffers[1].data();
+    int* actual = buffers[2].data();
+
+    previa[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        previa[j] = previa[j - 1] + cost_insert_table[codB[b0 + j - 1]];
+    }
+    for (int i = 1; i <= filas; ++i) {
+        char a = A[a0 + i - 1];
+        const int* filaSub = cost_matrix[codA[a0 + i - 1]].data();
+        const int borrar = cost_delete_table[codA[a0 + i - 1]];
+        actual[0] = previa[0] + borrar;
+        for (int j = 1; j <= n; ++j) {
+            char b = B[b0 + j - 1];
+            int valor = actual[j - 1] + cost_insert_table[codB[b0 + j - 1]];
+            valor = std::min(valor, previa[j] + borrar);
+            valor = std::min(valor, previa[j - 1] + filaSub[codB[b0 + j - 1]]);
+            if (i > 1 && j > 1 && a == B[b0 + j - 2] && A[a0 + i - 2] == b) {
+                valor = std::min(valor, previa2[j - 2] + cost_transpose_matrix[codA[a0 + i - 1]][codA[a0 + i - 2]]);
+            }
+            actual[j] = valor;
+        }
+        std::swap(previa2, previa);
+        std::swap(previa, actual);
+    }
+    anterior = previa2;
+    ultima = previa;
+    METRICA_FIN(inicioLlenado, llenadoNs);
+}
+
+// Calcular las dos primeras filas del DP hacia atrás: G[i][j] es el costo de transformar
+// A[i, a1) en B[j, b1). Igual que hacia adelante, rota entre las tres filas de 'filas'; al
+// terminar, 'primera' apunta a G[desde] y 'siguiente' a G[desde + 1] (indexadas por j - b0).
+void filasHaciaAtras(const std::string& A, const std::string& B, const std::vector<int>& codA,
+                     const std::vector<int>& codB, int desde, int a1, int b0, int b1,
+                     std::vector<int> (&buffers)[3], const int*& primera, const int*& siguiente) {
+    int n = b1 - b0;
+    METRICA_INICIO(inicioLlenado);
+    METRICA_SUMAR(celdas, 1ULL * (a1 - desde) * n);
+    METRICA_SUMAR(bytesDp, 3ULL * (n + 1) * sizeof(int));
+    int* posterior2 = buffers[0].data();
+    int* posterior = buffers[1].data();
+    int* actual = buffers[2].data();
+
+    posterior[n] = 0;
+    for (int j = n - 1; j >= 0; --j) {
+        posterior[j] = posterior[j + 1] + cost_insert_table[codB[b0 + j]];
+    }
+    for (int i = a1 - 1; i >= desde; --i) {
+        char a = A[i];
+        const int* filaSub = cost_matrix[codA[i]].data();
+        const int borrar = cost_delete_table[codA[i]];
+        actual[n] = posterior[n] + borrar;
+        for (int j = n - 1; j >= 0; --j) {
+            char b = B[b0 + j];
+            int valor = actual[j + 1] + cost_insert_table[codB[b0 + j]];
+            valor = std::min(valor, posterior[j] + borrar);
+            valor = std::min(valor, posterior[j + 1] + filaSub[codB[b0 + j]]);
+            // Transposición que empieza en (i, j): A[i]A[i+1] contra B[j]B[j+1]
+            if (i + 1 < a1 && j + 1 < n && a == B[b0 + j + 1] && A[i + 1] == b) {
+                valor = std::min(valor, posterior2[j + 2] + cost_transpose_matrix[codA[i + 1]][codA[i]]);
             }
-            --i;
-            --j;
-        } else if (i > 1 && j > 1 && dp[i][j] == dp[i - 2][j - 2] + cost_trans(A[i - 1], A[i - 2]) &&
-                A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1]) {
-            operaciones.push_back("Transponer '" + std::string(1, A[i - 2]) + "' y '" + std::string(1, A[i - 1]) + "' en posiciones " + std::to_string(i - 2) + " y " + std::to_string(i - 1));
-            i -= 2;
-            j -= 2;
+            actual[j] = valor;
+        }
+        std::swap(posterior2, posterior);
+        std::swap(posterior, actual);
+    }
+    primera = posterior;
+    siguiente = posterior2;
+    METRICA_FIN(inicioLlenado, llenadoNs);
+}
+
+// Filas de trabajo de Hirschberg: tres hacia adelante y tres hacia atrás, del ancho de la B
+// completa. Se reservan una vez por llamada y las comparten todos los niveles de la recursión,
+// porque cada nivel termina de usarlas (elige el corte) antes de llamar a los subproblemas.
+struct FilasHirschberg {
+    std::vector<int> adelante[3];
+    std::vector<int> atras[3];
+
+    explicit FilasHirschberg(int n) {
+        for (int k = 0; k < 3; ++k) {
+            adelante[k].resize(n + 1);
+            atras[k].resize(n + 1);
         }
     }
+};
 
+// Reconstrucción de Hirschberg sobre A[a0, a1) y B[b0, b1), agrega las operaciones en orden y
+// devuelve el costo del subproblema
+int reconstruirHirschberg(const std::string& A, const std::string& B, const std::vector<int>& codA,
+                          const std::vector<int>& codB, int a0, int a1, int b0, int b1,
+                          std::vector<EditOp>& operaciones, FilasHirschberg& filas,
+                          MemoriaReconstruccion& memoria) {
+    int m = a1 - a0;
+    int n = b1 - b0;
 
-    // Invertir las operaciones, ya que las hemos recolectado de atrás hacia adelante
-    std::reverse(operaciones.begin(), operaciones.end());
+    // Subproblemas pequeños: la tabla de punteros ocupa O(n) memoria
+    if (m <= 2 || n == 0 || static_cast<long long>(m + 1) * (n + 1) <= 4096) {
+        return reconstruirConPunteros(A, B, codA.data(), codB.data(), a0, a1, b0, b1, operaciones, memoria);
+    }
+
+    int medio = a0 + m / 2;
+    const int *adelanteAnterior, *adelante, *atras, *atrasSiguiente;
+    filasHaciaAdelante(A, B, codA, codB, a0, medio - a0, b0, b1, filas.adelante, adelanteAnterior, adelante);
+    filasHaciaAtras(A, B, codA, codB, medio, a1, b0, b1, filas.atras, atras, atrasSiguiente);
 
-    return dp[m][n];
+    // Todo camino óptimo pasa por una celda de la fila 'medio', o bien la salta con una
+    // transposición desde la fila medio - 1 hasta la fila medio + 1.
+    int mejor = INT_MAX;
+    int mejorJ = 0;
+    bool porTransposicion = false;
+    for (int j = 0; j <= n; ++j) {
+        int costo = adelante[j] + atras[j];
+        if (costo < mejor) {
+            mejor = costo;
+            mejorJ = j;
+            porTransposicion = false;
+        }
+    }
+    for (int j = 1; j + 1 <= n; ++j) {
+        // Transposición que termina en (medio + 1, j + 1): A[medio-1]A[medio] contra B[j-1]B[j]
+        if (A[medio] == B[b0 + j - 1] && A[medio - 1] == B[b0 + j]) {
+            int costo = adelanteAnterior[j - 1] + cost_transpose_matrix[codA[medio]][codA[medio - 1]] + atrasSiguiente[j + 1];
+            if (costo < mejor) {
+                mejor = costo;
+                mejorJ = j;
+                porTransposicion = true;
+            }
+        }
+    }
+
+    // Desde aquí las filas ya no se leen: los subproblemas las reutilizan
+    if (porTransposicion) {
+        reconstruirHirschberg(A, B, codA, codB, a0, medio - 1, b0, b0 + mejorJ - 1, operaciones, filas, memoria);
+        operaciones.push_back({TRANSPONER, medio - 1, b0 + mejorJ - 1});
+        reconstruirHirschberg(A, B, codA, codB, medio + 1, a1, b0 + mejorJ + 1, b1, operaciones, filas, memoria);
+    } else {
+        reconstruirHirschberg(A, B, codA, codB, a0, medio, b0, b0 + mejorJ, operaciones, filas, memoria);
+        reconstruirHirschberg(A, B, codA, codB, medio, a1, b0 + mejorJ, b1, operaciones, filas, memoria);
+    }
+    return mejor;
 }
 
-int main() {
+// Distancia mínima de edición con reconstrucción en memoria O(m + n) (divide y vencerás de Hirschberg):
+// seis filas del ancho de B, la pila de la recursión (O(log m) marcos) y la tabla de punteros del
+// caso base, que tiene a lo más 4096 celdas o 3 filas. Entrega una secuencia de operaciones de costo
+// mínimo; si hay empates puede elegir otra secuencia distinta a la de minEditDistance, pero con el
+// mismo costo total.
+int minEditDistanceHirschberg(const std::string& A, const std::string& B, std::vector<EditOp>& operaciones) {
+    int m = A.size();
+    int n = B.size();
+    std::vector<int> codA = codificarCadena(A);
+    std::vector<int> codB = codificarCadena(B);
+    // Solo la parte central después de quitar el prefijo y el sufijo comunes. La distancia sale
+    // del corte del primer nivel (o del caso base), sin una pasada aparte.
+    Recorte r = recortarComunes(A, B);
+    FilasHirschberg filas(n - r.prefijo - r.sufijo);
+    // Los casos base (tablas de punteros chicas) comparten una sola memoria de trabajo
+    MemoriaReconstruccion memoria;
+    return reconstruirHirschberg(A, B, codA, codB, r.prefijo, m - r.sufijo, r.prefijo, n - r.sufijo, operaciones,
+                                 filas, memoria);
+}
+
+// Generar una cadena aleatoria de letras minúsculas (para los experimentos)
+std::string generarCadenaAleatoria(int largo, unsigned semilla) {
+    std::mt19937 generador(semilla);
+    std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+    std::string cadena(largo, 'a');
+    for (char& c : cadena) {
+        c = static_cast<char>('a' + letra(generador));
+    }
+    return cadena;
+}
+
+// Memoria residente máxima del proceso en KB
+long memoriaPicoKB() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+// Generar un par (A, B) para la suite de experimentos. Tipos de carga:
+//  - aleatoria: A y B independientes
+//  - casi_igual: B es A con cerca de un 1% de sustituciones, inserciones y eliminaciones
+//  - repetitiva: A = "abab...", B igual pero con una 'c' en el medio
+//  - transposiciones: B es A con cada par de letras adyacentes intercambiado
+void generarCarga(const std::string& carga, int largo, unsigned semilla, std::string& A, std::string& B) {
+    std::mt19937 generador(semilla);
+    if (carga == "aleatoria") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = generarCadenaAleatoria(largo, semilla + 1);
+    } else if (carga == "casi_igual") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B.clear();
+        std::uniform_int_distribution<int> dado(0, 299);
+        std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+        for (char c : A) {
+            int tiro = dado(generador);
+            if (tiro == 0) {
+                B += static_cast<char>('a' + letra(generador)); // sustitución
+            } else if (tiro == 1) {
+                B += c;
+                B += static_cast<char>('a' + letra(generador)); // inserción
+            } else if (tiro != 2) {
+                B += c; // tiro == 2: eliminación
+            }
+        }
+    } else if (carga == "repetitiva") {
+        A.assign(largo, 'a');
+        for (int k = 1; k < largo; k += 2) {
+            A[k] = 'b';
+        }
+        B = A;
+        if (largo > 0) {
+            B[largo / 2] = 'c';
+        }
+    } else if (carga == "transposiciones") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = A;
+        for (int k = 0; k + 1 < largo; k += 2) {
+            std::swap(B[k], B[k + 1]);
+        }
+    } else {
+        throw std::invalid_argument("Carga desconocida: " + carga);
+    }
+}
+
+// Imprimir una fila CSV de la suite de experimentos a partir de los tiempos de cada repetición.
+// Columnas: programa,motor,carga,largo,semilla,repeticiones,mediana_us,p95_us,p99_us,
+// celdas_por_segundo,memoria_pico_kb,distancia
+void imprimirFilaBenchmark(const std::string& programa, const std::string& motor, const std::string& carga,
+                           int largo, unsigned semilla, std::vector<double> tiemposUs, double celdas, int distancia) {
+    std::sort(tiemposUs.begin(), tiemposUs.end());
+    auto percentil = [&](double p) {
+        size_t k = static_cast<size_t>(p * tiemposUs.size() + 0.999999);
+        return tiemposUs[std::min(tiemposUs.size() - 1, k == 0 ? 0 : k - 1)];
+    };
+    double mediana = percentil(0.50);
+    std::cout << programa << "," << motor << "," << carga << "," << largo << "," << semilla << ","
+              << tiemposUs.size() << "," << mediana << "," << percentil(0.95) << "," << percentil(0.99) << ","
+              << (mediana > 0 ? celdas / (mediana / 1e6) : 0.0) << "," << memoriaPicoKB() << "," << distancia << std::endl;
+}
+
+// Ejecutar un motor con calentamiento y repeticiones, y devolver los tiempos en microsegundos
+template <typename Motor>
+std::vector<double> medirRepeticiones(Motor motor, int calentamiento, int repeticiones, int& distancia) {
+    for (int r = 0; r < calentamiento; ++r) {
+        distancia = motor();
+    }
+    std::vector<double> tiempos;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto inicio = std::chrono::steady_clock::now();
+        distancia = motor();
+        auto fin = std::chrono::steady_clock::now();
+        tiempos.push_back(std::chrono::duration<double, std::micro>(fin - inicio).count());
+    }
+    return tiempos;
+}
+
+int main(int argc, char* argv[]) {
+#ifdef DP_METRICAS
+    std::atexit(exportarMetricas);
+#endif
     try {
-        cargar_matriz_costos("cost_replace.txt");
-        cargarTablaCostos("cost_insert.txt");
-        cargarTablaCostosEliminacion("cost_delete.txt");
-        cargarMatrizCostosTransposicion("cost_transpose.txt");
+        // Cargar las tablas de costos: desde un perfil binario si se indica con
+        // PERFIL_COSTOS=<archivo.bin>:<nombre> (ver ./DP --compilar-perfiles), o desde los archivos de texto
+        METRICA_INICIO(inicioCarga);
+        std::unique_ptr<ArchivoPerfiles> archivoPerfiles;
+        const char* perfil = std::getenv("PERFIL_COSTOS");
+        if (perfil != nullptr) {
+            std::string valor = perfil;
+            size_t separador = valor.rfind(':');
+            if (separador == std::string::npos) {
+                throw std::invalid_argument("PERFIL_COSTOS debe ser <archivo.bin>:<nombre>");
+            }
+            archivoPerfiles.reset(new ArchivoPerfiles(valor.substr(0, separador)));
+            archivoPerfiles->usar(valor.substr(separador + 1));
+            std::cout << "Perfil de costos '" << valor.substr(separador + 1) << "' cargado." << std::endl;
+        } else {
+            cargar_matriz_costos("cost_replace.txt");
+            cargarTablaCostos("cost_insert.txt");
+            cargarTablaCostosEliminacion("cost_delete.txt");
+            cargarMatrizCostosTransposicion("cost_transpose.txt");
+        }
+        revisarCostosNegativos();
+        prepararRecorte();
+        METRICA_FIN(inicioCarga, cargaNs);
+
+        std::string modo = argc > 1 ? argv[1] : "";
+
+        // Suite de experimentos (una fila CSV por ejecución, ver benchmark.sh):
+        // ./DPreconstructor --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>
+        // Motores: completa, hirschberg
+        if (modo == "--bench-suite") {
+            if (argc < 8) {
+                throw std::invalid_argument("Uso: --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>");
+            }
+            std::string motor = argv[2];
+            std::string carga = argv[3];
+            int largo = std::stoi(argv[4]);
+            unsigned semilla = std::stoul(argv[5]);
+            std::string A, B;
+            generarCarga(carga, largo, semilla, A, B);
+            if (motor != "completa" && motor != "hirschberg") {
+                throw std::invalid_argument("Motor desconocido: " + motor);
+            }
+
+            int distancia = 0;
+            std::vector<double> tiempos = medirRepeticiones([&] {
+                std::vector<EditOp> operaciones;
+                return motor == "hirschberg" ? minEditDistanceHirschberg(A, B, operaciones)
+                                             : minEditDistance(A, B, operaciones);
+            }, std::stoi(argv[7]), std::stoi(argv[6]), distancia);
+            imprimirFilaBenchmark("DPreconstructor", motor, carga, largo, semilla, tiempos,
+                                  static_cast<double>(A.size()) * B.size(), distancia);
+            return 0;
+        }
+
+        // Experimento: ./DPreconstructor --bench <completa|hirschberg> <largo>
+        // B es una copia de A con una letra cambiada cada 50 posiciones y algunas transposiciones.
+        // Se ejecuta una versión por proceso para que la memoria máxima no se mezcle.
+        if (modo == "--bench") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench <completa|hirschberg> <largo>");
+            }
+            std::string version = argv[2];
+            std::string A = generarCadenaAleatoria(std::stoi(argv[3]), 1);
+            std::string B = A;
+            for (size_t k = 0; k + 1 < B.size(); k += 50) {
+                if (k % 100 == 0) {
+                    std::swap(B[k], B[k + 1]);
+                } else {
+                    B[k] = static_cast<char>('a' + (B[k] - 'a' + 1) % ALPHABET_SIZE);
+                }
+            }
 
+            std::vector<EditOp> operaciones;
+            auto inicio = std::chrono::high_resolution_clock::now();
+            int result = version == "hirschberg" ? minEditDistanceHirschberg(A, B, operaciones)
+                                                 : minEditDistance(A, B, operaciones);
+            auto fin = std::chrono::high_resolution_clock::now();
+            auto duracion = std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio);
+
+            std::cout << "Versión: " << version << std::endl;
+            std::cout << "Distancia mínima de edición: " << result << std::endl;
+            std::cout << "Operaciones: " << operaciones.size() << std::endl;
+            if (version != "hirschberg") {
+                std::cout << "Tabla de punteros: " << (static_cast<double>(A.size() + 1) * (B.size() + 1) / 4) / 1024
+                          << " KB (2 bits por celda)" << std::endl;
+            }
+            std::cout << "El código tardó: " << duracion.count() << " microsegundos." << std::endl;
+            std::cout << "Memoria máxima: " << memoriaPicoKB() << " KB" << std::endl;
+            return 0;
+        }
+
+        // Memoria de trabajo reutilizable: ./DPreconstructor --bench-espacio <largo> <pares>
+        // Muchos pares cortos con reconstrucción, pidiendo memoria en cada llamada o reutilizando
+        // una MemoriaReconstruccion y el vector de operaciones. Los pedidos de memoria por llamada
+        // solo se cuentan si se compiló con -DDP_METRICAS.
+        if (modo == "--bench-espacio") {
+            if (argc < 4) {
+                throw std::invalid_argument("Uso: --bench-espacio <largo> <pares>");
+            }
+            int largo = std::stoi(argv[2]);
+            int cantidad = std::stoi(argv[3]);
+            std::vector<std::pair<std::string, std::string>> pares;
+            for (int p = 0; p < cantidad; ++p) {
+                std::string A, B;
+                generarCarga(p % 2 == 0 ? "aleatoria" : "casi_igual", largo, p + 1, A, B);
+                pares.emplace_back(A, B);
+            }
+
+            for (int reutilizar = 0; reutilizar < 2; ++reutilizar) {
+                MemoriaReconstruccion memoria;
+                std::vector<EditOp> operaciones;
+#ifdef DP_METRICAS
+                unsigned long long reservasAntes = metricas.reservas;
+#endif
+                long long suma = 0;
+                auto inicio = std::chrono::steady_clock::now();
+                for (const auto& par : pares) {
+                    if (reutilizar) {
+                        operaciones.clear();
+                        suma += minEditDistance(par.first, par.second, operaciones, memoria);
+                    } else {
+                        std::vector<EditOp> nuevas;
+                        suma += minEditDistance(par.first, par.second, nuevas);
+                    }
+                }
+                double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                std::cout << (reutilizar ? "Memoria reutilizada: " : "Memoria nueva en cada llamada: ")
+                          << cantidad / std::max(segundos, 1e-9) << " pares por segundo";
+#ifdef DP_METRICAS
+                std::cout << ", " << static_cast<double>(metricas.reservas - reservasAntes) / cantidad
+                          << " pedidos de memoria por llamada";
+#endif
+                std::cout << " (suma " << suma << ")" << std::endl;
+            }
+            return 0;
+        }
 
         // Cadenas de prueba
         std::string A = "ababababab";
         std::string B = "ababacabab";
 
         // Resultado de la distancia mínima de edición
-        std::vector<std::string> operaciones;
+        std::vector<EditOp> operaciones;
         int result = minEditDistance(A, B, operaciones);
         std::cout << "Distancia mínima de edición: " << result << std::endl;
 
         // Mostrar las operaciones realizadas
         std::cout << "Operaciones realizadas:" << std::endl;
-        for (const std::string& op : operaciones) {
-            std::cout << op << std::endl;
+        for (const EditOp& op : operaciones) {
+            std::cout << describirOperacion(op, A, B) << std::endl;
         }
 
     } catch (const std::exception& e) {
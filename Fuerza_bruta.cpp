@@ -7,16 +7,51 @@
 #include <algorithm>
 #include <climits> // Para valores como INT_MAX
 #include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <chrono> // Para medir el tiempo de ejecución
+#include <random> // Para generar cadenas de prueba
+#include <sys/resource.h> // Para medir la memoria máxima usada (getrusage)
 
 // Tamaño del alfabeto inglés (26 letras)
 const int ALPHABET_SIZE = 26;
 
 // Tablas y matrices globales para los costos de operaciones
-std::array<int, ALPHABET_SIZE> cost_delete_table; // Costos de eliminación
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix; // Costos de transposición
-std::array<int, ALPHABET_SIZE> cost_insert_table; // Costos de inserción
-std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix; // Costos de sustitución
+alignas(64) std::array<int, ALPHABET_SIZE> cost_delete_table; // Costos de eliminación
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_transpose_matrix; // Costos de transposición
+alignas(64) std::array<int, ALPHABET_SIZE> cost_insert_table; // Costos de inserción
+alignas(64) std::array<std::array<int, ALPHABET_SIZE>, ALPHABET_SIZE> cost_matrix; // Costos de sustitución
+
+// Métricas opcionales: compilar con -DDP_METRICAS. Sin esa bandera las macros no generan código.
+// Con ella se cuentan las consultas a las tablas de costos de los motores de búsqueda (las
+// llamadas recursivas ya se cuentan en llamadas_recursivas), se mide cada fase (carga de costos,
+// reserva de la tabla de memoización y búsqueda) y los bytes de esa tabla, y al terminar se
+// escribe todo como JSON en stderr o en el archivo indicado por METRICAS_JSON.
+#ifdef DP_METRICAS
+struct Metricas {
+    unsigned long long consultasCosto = 0;
+    unsigned long long bytesMemo = 0;
+    unsigned long long cargaNs = 0;
+    unsigned long long reservaNs = 0;
+    unsigned long long busquedaNs = 0;
+};
+Metricas metricas;
+
+#define METRICA_SUMAR(campo, valor) (metricas.campo += (valor))
+#define METRICA_INICIO(nombre) auto nombre = std::chrono::steady_clock::now()
+#define METRICA_FIN(nombre, campo) \
+    METRICA_SUMAR(campo, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - nombre).count())
+#else
+#define METRICA_SUMAR(campo, valor) ((void)0)
+#define METRICA_INICIO(nombre) ((void)0)
+#define METRICA_FIN(nombre, campo) ((void)0)
+#endif
 
 // Función para cargar la tabla de costos de eliminación desde un archivo
 void cargarTablaCostosEliminacion(const std::string& nombreArchivo) {
@@ -99,6 +134,119 @@ void cargar_matriz_costos(const std::string& filename) {
     file.close();
 }
 
+// Perfiles de costos binarios
+// Un archivo de perfiles guarda varias combinaciones de las cuatro tablas, ya validadas, para
+// cargarlas sin volver a leer texto. Formato (enteros en el orden de bytes de la máquina):
+//   EncabezadoPerfiles (64 bytes): "COSTOS01", versión, cantidad de perfiles y tamaño del alfabeto
+//   PerfilBinario por cada perfil: nombre, suma de verificación y las cuatro tablas, alineado a 64
+// El archivo se mapea en memoria (mmap) y se copia el perfil elegido a las tablas globales.
+const char MAGIA_PERFILES[8] = {'C', 'O', 'S', 'T', 'O', 'S', '0', '1'};
+const uint32_t VERSION_PERFILES = 1;
+
+struct alignas(64) EncabezadoPerfiles {
+    char magia[8];
+    uint32_t version;
+    uint32_t cantidad;
+    uint32_t alfabeto;
+};
+
+struct alignas(64) PerfilBinario {
+    char nombre[32];
+    uint64_t suma;      // FNV-1a de 64 bits sobre las cuatro tablas
+    char relleno[24];   // para que las tablas partan alineadas a 64 bytes
+    int32_t insertar[ALPHABET_SIZE];
+    int32_t eliminar[ALPHABET_SIZE];
+    int32_t sustituir[ALPHABET_SIZE][ALPHABET_SIZE];
+    int32_t transponer[ALPHABET_SIZE][ALPHABET_SIZE];
+};
+
+static_assert(sizeof(EncabezadoPerfiles) == 64, "El encabezado debe ocupar 64 bytes");
+static_assert(sizeof(PerfilBinario) % 64 == 0, "Cada perfil debe quedar alineado a 64 bytes");
+
+// Suma de verificación de las tablas de un perfil
+uint64_t sumaPerfil(const PerfilBinario& perfil) {
+    const unsigned char* inicio = reinterpret_cast<const unsigned char*>(perfil.insertar);
+    const unsigned char* fin = reinterpret_cast<const unsigned char*>(perfil.transponer + ALPHABET_SIZE);
+    uint64_t suma = 1469598103934665603ULL;
+    for (const unsigned char* p = inicio; p != fin; ++p) {
+        suma = (suma ^ *p) * 1099511628211ULL;
+    }
+    return suma;
+}
+
+// Archivo de perfiles mapeado en memoria; se mantiene abierto para poder cambiar de perfil
+class ArchivoPerfiles {
+public:
+    explicit ArchivoPerfiles(const std::string& ruta) {
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error al abrir el archivo de perfiles: " + ruta);
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(EncabezadoPerfiles))) {
+            close(descriptor);
+            throw std::runtime_error("Archivo de perfiles incompleto: " + ruta);
+        }
+        tamano = info.st_size;
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("No se pudo mapear el archivo de perfiles: " + ruta);
+        }
+        datos = static_cast<const unsigned char*>(mapa);
+
+        const EncabezadoPerfiles* encabezado = reinterpret_cast<const EncabezadoPerfiles*>(datos);
+        if (std::memcmp(encabezado->magia, MAGIA_PERFILES, sizeof(MAGIA_PERFILES)) != 0 ||
+            encabezado->version != VERSION_PERFILES || encabezado->alfabeto != ALPHABET_SIZE ||
+            tamano != sizeof(EncabezadoPerfiles) + encabezado->cantidad * sizeof(PerfilBinario)) {
+            munmap(const_cast<unsigned char*>(datos), tamano);
+            throw std::runtime_error("El archivo '" + ruta + "' no es un archivo de perfiles válido");
+        }
+        cantidad = encabezado->cantidad;
+        perfiles = reinterpret_cast<const PerfilBinario*>(datos + sizeof(EncabezadoPerfiles));
+    }
+
+    ~ArchivoPerfiles() {
+        munmap(const_cast<unsigned char*>(datos), tamano);
+    }
+
+    ArchivoPerfiles(const ArchivoPerfiles&) = delete;
+    ArchivoPerfiles& operator=(const ArchivoPerfiles&) = delete;
+
+    // Buscar un perfil por nombre y verificar su suma
+    const PerfilBinario& buscar(const std::string& nombre) const {
+        for (uint32_t k = 0; k < cantidad; ++k) {
+            if (nombre == std::string(perfiles[k].nombre, strnlen(perfiles[k].nombre, sizeof(perfiles[k].nombre)))) {
+                if (sumaPerfil(perfiles[k]) != perfiles[k].suma) {
+                    throw std::runtime_error("El perfil '" + nombre + "' está corrupto (suma de verificación)");
+                }
+                return perfiles[k];
+            }
+        }
+        throw std::runtime_error("No existe el perfil: " + nombre);
+    }
+
+    // Copiar un perfil a las tablas globales (cambiar de modelo de costos sin leer texto)
+    void usar(const std::string& nombre) const {
+        const PerfilBinario& perfil = buscar(nombre);
+        for (int a = 0; a < ALPHABET_SIZE; ++a) {
+            cost_insert_table[a] = perfil.insertar[a];
+            cost_delete_table[a] = perfil.eliminar[a];
+            for (int b = 0; b < ALPHABET_SIZE; ++b) {
+                cost_matrix[a][b] = perfil.sustituir[a][b];
+                cost_transpose_matrix[a][b] = perfil.transponer[a][b];
+            }
+        }
+    }
+
+    uint32_t cantidad = 0;
+    const PerfilBinario* perfiles = nullptr;
+
+private:
+    const unsigned char* datos = nullptr;
+    size_t tamano = 0;
+};
+
 // Función que calcula el costo de sustitución entre dos caracteres
 int costo_sub(char a, char b) {
     int index_a = tolower(a) - 'a';
@@ -114,9 +262,8 @@ int costo_sub(char a, char b) {
 
 // Función que devuelve el costo de insertar un carácter
 int cost_ins(char b) {
-    if (!std::isalpha(b)) {
-        std::cerr << "El carácter '" << b << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument(std::string("El carácter '") + b + "' no es una letra válida.");
     }
 
     b = std::tolower(b);
@@ -126,9 +273,8 @@ int cost_ins(char b) {
 
 // Función que calcula el costo de transponer dos caracteres
 int cost_trans(char a, char b) {
-    if (!std::isalpha(a) || !std::isalpha(b)) {
-        std::cerr << "Uno o ambos caracteres no son letras válidas." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a)) || !std::isalpha(static_cast<unsigned char>(b))) {
+        throw std::invalid_argument("Uno o ambos caracteres no son letras válidas.");
     }
 
     a = std::tolower(a);
@@ -141,9 +287,8 @@ int cost_trans(char a, char b) {
 
 // Función que devuelve el costo de eliminar un carácter
 int cost_del(char a) {
-    if (!std::isalpha(a)) {
-        std::cerr << "El carácter '" << a << "' no es una letra válida." << std::endl;
-        return -1;
+    if (!std::isalpha(static_cast<unsigned char>(a))) {
+        throw std::invalid_argument(std::string("El carácter '") + a + "' no es una letra válida.");
     }
 
     a = std::tolower(a);
@@ -151,44 +296,406 @@ int cost_del(char a) {
     return cost_delete_table[index];
 }
 
+// Contador de llamadas recursivas (visitas a subproblemas) de los motores de búsqueda
+long long llamadas_recursivas = 0;
+
+#ifdef DP_METRICAS
+// Escribir las métricas como JSON (se registra con atexit al comenzar main)
+void exportarMetricas() {
+    std::ofstream archivo;
+    const char* ruta = std::getenv("METRICAS_JSON");
+    if (ruta != nullptr) {
+        archivo.open(ruta);
+    }
+    std::ostream& salida = archivo.is_open() ? static_cast<std::ostream&>(archivo) : std::cerr;
+    salida << "{\"programa\": \"Fuerza_bruta\", \"llamadas_recursivas\": " << llamadas_recursivas
+           << ", \"consultas_costo\": " << metricas.consultasCosto
+           << ", \"bytes_memo\": " << metricas.bytesMemo
+           << ", \"fases_us\": {\"carga\": " << metricas.cargaNs / 1000.0
+           << ", \"reserva\": " << metricas.reservaNs / 1000.0
+           << ", \"busqueda\": " << metricas.busquedaNs / 1000.0 << "}}" << std::endl;
+}
+#endif
+
+// Función que convierte una cadena a índices del alfabeto (0..25), validando cada carácter una sola vez
+std::vector<int> codificarCadena(const std::string& cadena) {
+    std::vector<int> codigos(cadena.size());
+    for (size_t k = 0; k < cadena.size(); ++k) {
+        unsigned char c = static_cast<unsigned char>(cadena[k]);
+        if (!std::isalpha(c)) {
+            throw std::invalid_argument("El carácter '" + std::string(1, cadena[k]) + "' no es una letra válida.");
+        }
+        codigos[k] = std::tolower(c) - 'a';
+    }
+    return codigos;
+}
+
+// Si alguna tabla cargada tiene costos negativos el recorte (y las podas que suponen costos no
+// negativos) dejan de valer. En true hasta revisarCostosNegativos().
+bool costos_negativos = true;
+
+// Revisar las cuatro tablas una vez; se llama después de cargarlas
+void revisarCostosNegativos() {
+    bool negativos = false;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        negativos = negativos || cost_insert_table[a] < 0 || cost_delete_table[a] < 0;
+        for (int b = 0; b < ALPHABET_SIZE; ++b) {
+            negativos = negativos || cost_matrix[a][b] < 0 || cost_transpose_matrix[a][b] < 0;
+        }
+    }
+    costos_negativos = negativos;
+}
+
+// Etapa de reducción, la misma de DP.cpp: se quitan el prefijo y el sufijo comunes cuando la letra
+// x que se quita cumple, para toda letra y, ins(y) <= ins(x) + sub(x, y) y del(y) <= del(x) + sub(y, x)
+// (y sustituir una letra por sí misma cuesta 0 en todo el alfabeto); con eso la distancia no cambia.
+std::array<bool, ALPHABET_SIZE> letraRecortable{}; // sin recorte hasta llamar a prepararRecorte()
+
+// Revisar la condición para cada letra (sin recorte si hay costos negativos); se llama después
+// de revisarCostosNegativos()
+void prepararRecorte() {
+    bool identidadGratis = !costos_negativos;
+    for (int a = 0; a < ALPHABET_SIZE; ++a) {
+        identidadGratis = identidadGratis && cost_matrix[a][a] == 0;
+    }
+    for (int x = 0; x < ALPHABET_SIZE; ++x) {
+        bool recortable = identidadGratis;
+        for (int y = 0; y < ALPHABET_SIZE && recortable; ++y) {
+            recortable = cost_insert_table[y] <= cost_insert_table[x] + cost_matrix[x][y] &&
+                         cost_delete_table[y] <= cost_delete_table[x] + cost_matrix[y][x];
+        }
+        letraRecortable[x] = recortable;
+    }
+}
+
+struct Recorte {
+    int prefijo = 0;
+    int sufijo = 0;
+};
+
+// Largo del prefijo y del sufijo comunes que se pueden quitar (sin solaparse); compara los
+// caracteres tal cual, como la transposición
+Recorte recortarComunes(const std::string& A, const std::string& B) {
+    auto recortable = [](char c) {
+        unsigned char u = static_cast<unsigned char>(c);
+        return std::isalpha(u) && letraRecortable[std::tolower(u) - 'a'];
+    };
+    Recorte r;
+    int largo = std::min(A.size(), B.size());
+    while (r.prefijo < largo && A[r.prefijo] == B[r.prefijo] && recortable(A[r.prefijo])) {
+        ++r.prefijo;
+    }
+    while (r.sufijo < largo - r.prefijo && A[A.size() - 1 - r.sufijo] == B[B.size() - 1 - r.sufijo] &&
+           recortable(A[A.size() - 1 - r.sufijo])) {
+        ++r.sufijo;
+    }
+    return r;
+}
+
+// Resolver con la etapa de reducción delante: 'motor' recibe la parte central de A y B y sus
+// códigos. Lo que queda vacío o de una letra lo resuelven los casos base de la recursión.
+template <typename Motor>
+int conReduccion(const std::string& A, const std::string& B, Motor motor) {
+    Recorte r = recortarComunes(A, B);
+    std::string parteA = A.substr(r.prefijo, A.size() - r.prefijo - r.sufijo);
+    std::string parteB = B.substr(r.prefijo, B.size() - r.prefijo - r.sufijo);
+    return motor(parteA, parteB, codificarCadena(parteA), codificarCadena(parteB));
+}
+
 // Función de distancia mínima de edición (algoritmo recursivo de fuerza bruta)
-int minEditDistance(const std::string& A, const std::string& B, int i, int j) {
+// codA y codB son A y B ya codificadas con codificarCadena, para no validar en cada llamada
+int minEditDistance(const std::string& A, const std::string& B, const std::vector<int>& codA,
+                    const std::vector<int>& codB, int i, int j) {
+    ++llamadas_recursivas;
+
     // Caso base: una de las cadenas está vacía
     if (i == -1) {
         int total_cost = 0;
         for (int k = j; k >= 0; --k) {
-            total_cost += cost_ins(B[k]); // Costos de insertar el resto de caracteres
+            total_cost += cost_insert_table[codB[k]]; // Costos de insertar el resto de caracteres
         }
+        METRICA_SUMAR(consultasCosto, j + 1);
         return total_cost;
     }
     if (j == -1) {
         int total_cost = 0;
         for (int k = i; k >= 0; --k) {
-            total_cost += cost_del(A[k]); // Costos de eliminar el resto de caracteres
+            total_cost += cost_delete_table[codA[k]]; // Costos de eliminar el resto de caracteres
         }
+        METRICA_SUMAR(consultasCosto, i + 1);
         return total_cost;
     }
 
     // Opciones: inserción, eliminación, sustitución, transposición
-    int cost_insert = minEditDistance(A, B, i, j - 1) + cost_ins(B[j]);
-    int cost_delete = minEditDistance(A, B, i - 1, j) + cost_del(A[i]);
-    int cost_substitute = minEditDistance(A, B, i - 1, j - 1) + costo_sub(A[i], B[j]);
+    int cost_insert = minEditDistance(A, B, codA, codB, i, j - 1) + cost_insert_table[codB[j]];
+    int cost_delete = minEditDistance(A, B, codA, codB, i - 1, j) + cost_delete_table[codA[i]];
+    int cost_substitute = minEditDistance(A, B, codA, codB, i - 1, j - 1) + cost_matrix[codA[i]][codB[j]];
+    METRICA_SUMAR(consultasCosto, 3);
 
     int cost_transpose = INT_MAX;
     if (i - 1 >= 0 && j - 1 >= 0 && A[i] == B[j - 1] && A[i - 1] == B[j]) {
-        cost_transpose = minEditDistance(A, B, i - 2, j - 2) + cost_trans(A[i], B[j]);
+        cost_transpose = minEditDistance(A, B, codA, codB, i - 2, j - 2) + cost_transpose_matrix[codA[i]][codB[j]];
+        METRICA_SUMAR(consultasCosto, 1);
     }
 
     // Retornar el mínimo costo de todas las operaciones
     return std::min({cost_insert, cost_delete, cost_substitute, cost_transpose});
 }
 
-int main() {
-    // Cargar las tablas y matrices de costos desde archivos
-    cargar_matriz_costos("cost_replace.txt");
-    cargarTablaCostos("cost_insert.txt");
-    cargarTablaCostosEliminacion("cost_delete.txt");
-    cargarMatrizCostosTransposicion("cost_transpose.txt");
+// Motor de búsqueda con memoización y poda (ramificación y acotamiento)
+// Resuelve el mismo problema que minEditDistance(A, B, codA, codB, i, j), pero:
+//  - guarda el resultado de cada subproblema (i, j) para no resolverlo dos veces,
+//  - usa sumas prefijas para los casos base en vez de recorrer el resto de la cadena,
+//  - descarta una opción cuando su costo más una cota inferior del subproblema restante no puede
+//    mejorar la mejor opción ya encontrada. La cota es la diferencia de largos por el costo
+//    mínimo de inserción o eliminación, que nunca sobreestima si los costos son no negativos;
+//    con costos negativos no se poda (solo queda la memoización).
+struct BusquedaMemo {
+    static constexpr int SIN_RESOLVER = INT_MIN; // una distancia puede ser negativa: -1 no sirve
+
+    const std::string& A;
+    const std::string& B;
+    const std::vector<int>& codA;
+    const std::vector<int>& codB;
+    std::vector<int> memo;           // memo[(i + 1) * (n + 1) + (j + 1)], SIN_RESOLVER si falta
+    std::vector<int> prefijoIns;     // prefijoIns[j + 1] = costo de insertar B[0..j]
+    std::vector<int> prefijoDel;     // prefijoDel[i + 1] = costo de eliminar A[0..i]
+    int minIns;
+    int minDel;
+    bool podar;                      // false si hay costos negativos
+    long long podas = 0;
+
+    BusquedaMemo(const std::string& A_, const std::string& B_, const std::vector<int>& codA_,
+                 const std::vector<int>& codB_)
+        : A(A_), B(B_), codA(codA_), codB(codB_),
+          memo((A_.size() + 1) * (B_.size() + 1), SIN_RESOLVER),
+          prefijoIns(B_.size() + 1, 0), prefijoDel(A_.size() + 1, 0), podar(!costos_negativos) {
+        for (size_t j = 0; j < B.size(); ++j) {
+            prefijoIns[j + 1] = prefijoIns[j] + cost_insert_table[codB[j]];
+        }
+        for (size_t i = 0; i < A.size(); ++i) {
+            prefijoDel[i + 1] = prefijoDel[i] + cost_delete_table[codA[i]];
+        }
+        minIns = *std::min_element(cost_insert_table.begin(), cost_insert_table.end());
+        minDel = *std::min_element(cost_delete_table.begin(), cost_delete_table.end());
+    }
+
+    // Cota inferior del costo de transformar A[0..i] en B[0..j]
+    int cotaInferior(int i, int j) const {
+        return j > i ? (j - i) * minIns : (i - j) * minDel;
+    }
+
+    int resolver(int i, int j) {
+        ++llamadas_recursivas;
+
+        // Caso base: una de las cadenas está vacía
+        if (i == -1) {
+            return prefijoIns[j + 1];
+        }
+        if (j == -1) {
+            return prefijoDel[i + 1];
+        }
+
+        int& guardado = memo[(i + 1) * (B.size() + 1) + (j + 1)];
+        if (guardado != SIN_RESOLVER) {
+            return guardado;
+        }
+
+        // Opciones: se prueba primero la sustitución y la transposición, que suelen ser las más
+        // baratas, para que las demás se puedan podar
+        int mejor = cost_matrix[codA[i]][codB[j]] + resolver(i - 1, j - 1);
+        METRICA_SUMAR(consultasCosto, 3);
+        if (i - 1 >= 0 && j - 1 >= 0 && A[i] == B[j - 1] && A[i - 1] == B[j]) {
+            int costo = cost_transpose_matrix[codA[i]][codB[j]];
+            METRICA_SUMAR(consultasCosto, 1);
+            if (!podar || costo + cotaInferior(i - 2, j - 2) < mejor) {
+                mejor = std::min(mejor, costo + resolver(i - 2, j - 2));
+            } else {
+                ++podas;
+            }
+        }
+        if (!podar || cost_insert_table[codB[j]] + cotaInferior(i, j - 1) < mejor) {
+            mejor = std::min(mejor, cost_insert_table[codB[j]] + resolver(i, j - 1));
+        } else {
+            ++podas;
+        }
+        if (!podar || cost_delete_table[codA[i]] + cotaInferior(i - 1, j) < mejor) {
+            mejor = std::min(mejor, cost_delete_table[codA[i]] + resolver(i - 1, j));
+        } else {
+            ++podas;
+        }
+
+        guardado = mejor;
+        return mejor;
+    }
+};
+
+// Función que genera una cadena aleatoria de letras minúsculas (para los experimentos)
+std::string generarCadenaAleatoria(int largo, unsigned semilla) {
+    std::mt19937 generador(semilla);
+    std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+    std::string cadena(largo, 'a');
+    for (char& c : cadena) {
+        c = static_cast<char>('a' + letra(generador));
+    }
+    return cadena;
+}
+
+// Función que devuelve la memoria residente máxima del proceso en KB
+long memoriaPicoKB() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+// Generar un par (A, B) para la suite de experimentos. Tipos de carga:
+//  - aleatoria: A y B independientes
+//  - casi_igual: B es A con cerca de un 1% de sustituciones, inserciones y eliminaciones
+//  - repetitiva: A = "abab...", B igual pero con una 'c' en el medio
+//  - transposiciones: B es A con cada par de letras adyacentes intercambiado
+void generarCarga(const std::string& carga, int largo, unsigned semilla, std::string& A, std::string& B) {
+    std::mt19937 generador(semilla);
+    if (carga == "aleatoria") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = generarCadenaAleatoria(largo, semilla + 1);
+    } else if (carga == "casi_igual") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B.clear();
+        std::uniform_int_distribution<int> dado(0, 299);
+        std::uniform_int_distribution<int> letra(0, ALPHABET_SIZE - 1);
+        for (char c : A) {
+            int tiro = dado(generador);
+            if (tiro == 0) {
+                B += static_cast<char>('a' + letra(generador)); // sustitución
+            } else if (tiro == 1) {
+                B += c;
+                B += static_cast<char>('a' + letra(generador)); // inserción
+            } else if (tiro != 2) {
+                B += c; // tiro == 2: eliminación
+            }
+        }
+    } else if (carga == "repetitiva") {
+        A.assign(largo, 'a');
+        for (int k = 1; k < largo; k += 2) {
+            A[k] = 'b';
+        }
+        B = A;
+        if (largo > 0) {
+            B[largo / 2] = 'c';
+        }
+    } else if (carga == "transposiciones") {
+        A = generarCadenaAleatoria(largo, semilla);
+        B = A;
+        for (int k = 0; k + 1 < largo; k += 2) {
+            std::swap(B[k], B[k + 1]);
+        }
+    } else {
+        throw std::invalid_argument("Carga desconocida: " + carga);
+    }
+}
+
+// Imprimir una fila CSV de la suite de experimentos a partir de los tiempos de cada repetición.
+// Columnas: programa,motor,carga,largo,semilla,repeticiones,mediana_us,p95_us,p99_us,
+// celdas_por_segundo,memoria_pico_kb,distancia
+void imprimirFilaBenchmark(const std::string& programa, const std::string& motor, const std::string& carga,
+                           int largo, unsigned semilla, std::vector<double> tiemposUs, double celdas, int distancia) {
+    std::sort(tiemposUs.begin(), tiemposUs.end());
+    auto percentil = [&](double p) {
+        size_t k = static_cast<size_t>(p * tiemposUs.size() + 0.999999);
+        return tiemposUs[std::min(tiemposUs.size() - 1, k == 0 ? 0 : k - 1)];
+    };
+    double mediana = percentil(0.50);
+    std::cout << programa << "," << motor << "," << carga << "," << largo << "," << semilla << ","
+              << tiemposUs.size() << "," << mediana << "," << percentil(0.95) << "," << percentil(0.99) << ","
+              << (mediana > 0 ? celdas / (mediana / 1e6) : 0.0) << "," << memoriaPicoKB() << "," << distancia << std::endl;
+}
+
+// Ejecutar un motor con calentamiento y repeticiones, y devolver los tiempos en microsegundos
+template <typename Motor>
+std::vector<double> medirRepeticiones(Motor motor, int calentamiento, int repeticiones, int& distancia) {
+    for (int r = 0; r < calentamiento; ++r) {
+        distancia = motor();
+    }
+    std::vector<double> tiempos;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto inicio = std::chrono::steady_clock::now();
+        distancia = motor();
+        auto fin = std::chrono::steady_clock::now();
+        tiempos.push_back(std::chrono::duration<double, std::micro>(fin - inicio).count());
+    }
+    return tiempos;
+}
+
+int main(int argc, char* argv[]) {
+#ifdef DP_METRICAS
+    std::atexit(exportarMetricas);
+#endif
+    // Cargar las tablas de costos: desde un perfil binario si se indica con
+    // PERFIL_COSTOS=<archivo.bin>:<nombre> (ver ./DP --compilar-perfiles), o desde los archivos de texto
+    METRICA_INICIO(inicioCarga);
+    std::unique_ptr<ArchivoPerfiles> archivoPerfiles;
+    const char* perfil = std::getenv("PERFIL_COSTOS");
+    if (perfil != nullptr) {
+        std::string valor = perfil;
+        size_t separador = valor.rfind(':');
+        if (separador == std::string::npos) {
+            throw std::invalid_argument("PERFIL_COSTOS debe ser <archivo.bin>:<nombre>");
+        }
+        archivoPerfiles.reset(new ArchivoPerfiles(valor.substr(0, separador)));
+        archivoPerfiles->usar(valor.substr(separador + 1));
+        std::cout << "Perfil de costos '" << valor.substr(separador + 1) << "' cargado." << std::endl;
+    } else {
+        cargar_matriz_costos("cost_replace.txt");
+        cargarTablaCostos("cost_insert.txt");
+        cargarTablaCostosEliminacion("cost_delete.txt");
+        cargarMatrizCostosTransposicion("cost_transpose.txt");
+    }
+    revisarCostosNegativos();
+    prepararRecorte();
+    METRICA_FIN(inicioCarga, cargaNs);
+
+    // Suite de experimentos (una fila CSV por ejecución, ver benchmark.sh):
+    // ./Fuerza_bruta --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>
+    // Motores: bruta, memo
+    if (argc > 1 && std::string(argv[1]) == "--bench-suite") {
+        if (argc < 8) {
+            std::cerr << "Uso: --bench-suite <motor> <carga> <largo> <semilla> <repeticiones> <calentamiento>" << std::endl;
+            return 1;
+        }
+        std::string motor = argv[2];
+        std::string carga = argv[3];
+        int largo = std::stoi(argv[4]);
+        unsigned semilla = std::stoul(argv[5]);
+        std::string A, B;
+        generarCarga(carga, largo, semilla, A, B);
+        std::vector<int> codA = codificarCadena(A);
+        std::vector<int> codB = codificarCadena(B);
+        if (motor != "bruta" && motor != "memo") {
+            std::cerr << "Motor desconocido: " << motor << std::endl;
+            return 1;
+        }
+
+        int distancia = 0;
+        std::vector<double> tiempos = medirRepeticiones([&] {
+            if (motor == "memo") {
+                METRICA_INICIO(inicioReserva);
+                BusquedaMemo busqueda(A, B, codA, codB);
+                METRICA_FIN(inicioReserva, reservaNs);
+                METRICA_SUMAR(bytesMemo, busqueda.memo.size() * sizeof(int));
+                METRICA_INICIO(inicioBusqueda);
+                int resultado = busqueda.resolver(A.size() - 1, B.size() - 1);
+                METRICA_FIN(inicioBusqueda, busquedaNs);
+                return resultado;
+            }
+            METRICA_INICIO(inicioBusqueda);
+            int resultado = minEditDistance(A, B, codA, codB, A.size() - 1, B.size() - 1);
+            METRICA_FIN(inicioBusqueda, busquedaNs);
+            return resultado;
+        }, std::stoi(argv[7]), std::stoi(argv[6]), distancia);
+        imprimirFilaBenchmark("Fuerza_bruta", motor, carga, largo, semilla, tiempos,
+                              static_cast<double>(A.size()) * B.size(), distancia);
+        return 0;
+    }
 
     // Cadenas de prueba, ACA CAMBIAR PARA LOS CASOS DE PRUEBA
     std::string A = "ababababab";
@@ -196,9 +703,37 @@ int main() {
 
     auto inicio = std::chrono::high_resolution_clock::now(); // Iniciar temporizador
 
-    // Calcular distancia mínima de edición
-    int result = minEditDistance(A, B, A.size() - 1, B.size() - 1);
-    std::cout << "Distancia mínima de edición (Fuerza Bruta): " << result << std::endl;
+    // Calcular distancia mínima de edición. Por defecto se usa la fuerza bruta pura (la línea base
+    // exponencial de los experimentos); con "--memo" se usa la búsqueda con memoización y poda.
+    // En ambos casos la búsqueda recibe solo lo que queda después de la etapa de reducción.
+    std::string motor = argc > 1 ? argv[1] : "";
+    if (motor == "--memo") {
+        long long podas = 0;
+        int result = conReduccion(A, B, [&](const std::string& a, const std::string& b, const std::vector<int>& codA,
+                                            const std::vector<int>& codB) {
+            METRICA_INICIO(inicioReserva);
+            BusquedaMemo busqueda(a, b, codA, codB);
+            METRICA_FIN(inicioReserva, reservaNs);
+            METRICA_SUMAR(bytesMemo, busqueda.memo.size() * sizeof(int));
+            METRICA_INICIO(inicioBusqueda);
+            int resultado = busqueda.resolver(a.size() - 1, b.size() - 1);
+            METRICA_FIN(inicioBusqueda, busquedaNs);
+            podas = busqueda.podas;
+            return resultado;
+        });
+        std::cout << "Distancia mínima de edición (Memoización y poda): " << result << std::endl;
+        std::cout << "Podas: " << podas << std::endl;
+    } else {
+        int result = conReduccion(A, B, [](const std::string& a, const std::string& b, const std::vector<int>& codA,
+                                           const std::vector<int>& codB) {
+            METRICA_INICIO(inicioBusqueda);
+            int resultado = minEditDistance(a, b, codA, codB, a.size() - 1, b.size() - 1);
+            METRICA_FIN(inicioBusqueda, busquedaNs);
+            return resultado;
+        });
+        std::cout << "Distancia mínima de edición (Fuerza Bruta): " << result << std::endl;
+    }
+    std::cout << "Llamadas recursivas: " << llamadas_recursivas << std::endl;
 
     auto fin = std::chrono::high_resolution_clock::now(); // Finalizar temporizador
     auto duracion = std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio);
@@ -0,0 +1,51 @@
+#!/bin/sh
+# Suite de experimentos: compila los tres programas y corre cada motor sobre las cargas de prueba
+# (aleatoria, casi_igual, repetitiva, transposiciones) a varios largos. Cada medición es un proceso
+# aparte para que la memoria máxima sea la de ese motor. El resultado queda en un CSV.
+#
+# Uso (en la carpeta donde están los archivos cost_*.txt):
+#   ./benchmark.sh [salida.csv]
+# Variables opcionales: REPETICIONES, CALENTAMIENTO, SEMILLA, LARGOS_DP, LIMITE_FB_US
+set -e
+
+SALIDA=${1:-resultados.csv}
+REPETICIONES=${REPETICIONES:-21}
+CALENTAMIENTO=${CALENTAMIENTO:-2}
+SEMILLA=${SEMILLA:-1}
+LARGOS_DP=${LARGOS_DP:-"10 100 500 1000 2000 5000"}
+# La fuerza bruta sube de largo en largo hasta que la mediana pasa este límite (microsegundos)
+LIMITE_FB_US=${LIMITE_FB_US:-1000000}
+
+FUENTES=$(dirname "$0")
+g++ -O2 -pthread "$FUENTES/DP.cpp" -o DP
+g++ -O2 -pthread "$FUENTES/DPreconstructor (para secuencias).cpp" -o DPreconstructor
+g++ -O2 "$FUENTES/Fuerza_bruta.cpp" -o Fuerza_bruta
+
+echo "programa,motor,carga,largo,semilla,repeticiones,mediana_us,p95_us,p99_us,celdas_por_segundo,memoria_pico_kb,distancia" > "$SALIDA"
+
+for carga in aleatoria casi_igual repetitiva transposiciones; do
+    for largo in $LARGOS_DP; do
+        for motor in dp lineal rapida angosta diagonal damerau; do
+            ./DP --bench-suite $motor $carga $largo $SEMILLA $REPETICIONES $CALENTAMIENTO | tail -n 1 >> "$SALIDA"
+        done
+        for motor in completa hirschberg; do
+            ./DPreconstructor --bench-suite $motor $carga $largo $SEMILLA $REPETICIONES $CALENTAMIENTO | tail -n 1 >> "$SALIDA"
+        done
+    done
+
+    # Fuerza bruta: largo creciente hasta que deja de ser factible
+    for motor in bruta memo; do
+        largo=1
+        while [ $largo -le 40 ]; do
+            fila=$(./Fuerza_bruta --bench-suite $motor $carga $largo $SEMILLA 5 1 | tail -n 1)
+            echo "$fila" >> "$SALIDA"
+            mediana=$(echo "$fila" | cut -d, -f7)
+            if awk "BEGIN { exit !($mediana > $LIMITE_FB_US) }"; then
+                break
+            fi
+            largo=$((largo + 1))
+        done
+    done
+done
+
+echo "Resultados en $SALIDA"